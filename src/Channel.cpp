@@ -0,0 +1,200 @@
+#include "Channel.h"
+#include "Natives.h"
+#include <thread>
+
+static size_t roundToPowerOf2(size_t capacity)
+{
+	size_t size = 2; //the sequence numbers need at least 2 cells
+	while (size < capacity) size *= 2;
+	return size;
+}
+
+Channel::Channel(size_t capacity)
+	:
+	cells(std::make_unique<Cell[]>(roundToPowerOf2(capacity))),
+	mask(roundToPowerOf2(capacity) - 1),
+	sendPos(0),
+	receivePos(0),
+	closed(false),
+	sleepers(0)
+{
+	for (size_t i = 0; i <= mask; i++)
+		cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool Channel::trySend(Value& value)
+{
+	if (closed.load(std::memory_order_relaxed))
+		throw runtime_error(u8"Es kann nichts an einen geschlossenen Kanal gesendet werden!");
+	if (!push(value)) return false;
+	wakeSleepers();
+	return true;
+}
+
+bool Channel::tryReceive(Value& value)
+{
+	if (!pop(value)) return false;
+	wakeSleepers();
+	return true;
+}
+
+bool Channel::push(Value& value)
+{
+	size_t pos = sendPos.load(std::memory_order_relaxed);
+	while (true)
+	{
+		Cell& cell = cells[pos & mask];
+		size_t sequence = cell.sequence.load(std::memory_order_acquire);
+		ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)pos;
+		if (diff == 0)
+		{
+			//the cell is free, claim it
+			if (sendPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				cell.value = std::move(value);
+				cell.sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (diff < 0)
+			return false; //the cell still holds the value sent one round earlier
+		else
+			pos = sendPos.load(std::memory_order_relaxed); //another sender was faster
+	}
+}
+
+bool Channel::pop(Value& value)
+{
+	size_t pos = receivePos.load(std::memory_order_relaxed);
+	while (true)
+	{
+		Cell& cell = cells[pos & mask];
+		size_t sequence = cell.sequence.load(std::memory_order_acquire);
+		ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)(pos + 1);
+		if (diff == 0)
+		{
+			if (receivePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				value = std::move(cell.value);
+				cell.value = Value();
+				//free the cell for the sender of the next round
+				cell.sequence.store(pos + mask + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (diff < 0)
+			return false; //nothing was sent to this cell yet
+		else
+			pos = receivePos.load(std::memory_order_relaxed);
+	}
+}
+
+void Channel::send(Value& value)
+{
+	if (trySend(value)) return;
+
+	bool sent = false;
+	waitUntil([&] { return (sent = push(value)) || closed.load(); });
+	if (sent)
+		wakeSleepers();
+	else
+		throw runtime_error(u8"Es kann nichts an einen geschlossenen Kanal gesendet werden!");
+}
+
+bool Channel::receive(Value& value)
+{
+	if (tryReceive(value)) return true;
+
+	bool received = false;
+	waitUntil([&] { return (received = pop(value)) || (closed.load() && !hasValue()); });
+	if (received) wakeSleepers();
+	return received;
+}
+
+bool Channel::atEnd()
+{
+	waitUntil([&] { return hasValue() || closed.load(); });
+	return !hasValue();
+}
+
+void Channel::close()
+{
+	closed.store(true);
+	wakeSleepers();
+}
+
+template<typename Ready>
+void Channel::waitUntil(Ready ready)
+{
+	//the other side is often just about to run, which is a lot cheaper than sleeping and waking up
+	for (int i = 0; i < SpinCount; i++)
+	{
+		if (ready()) return;
+		std::this_thread::yield();
+	}
+
+	std::unique_lock<std::mutex> lock(mutex);
+	sleepers.fetch_add(1);
+	//pairs with the fence in wakeSleepers: either the change is seen below or the changing thread sees this sleeper
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	while (!ready())
+		changed.wait(lock);
+	sleepers.fetch_sub(1);
+}
+
+void Channel::wakeSleepers()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (sleepers.load(std::memory_order_relaxed) == 0) return;
+	//a sleeper holds the mutex from its last check until it waits, so it can't miss the notification
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+	}
+	changed.notify_all();
+}
+
+bool Channel::hasValue() const
+{
+	size_t pos = receivePos.load(std::memory_order_relaxed);
+	return cells[pos & mask].sequence.load(std::memory_order_acquire) == pos + 1;
+}
+
+ChannelTable::ChannelTable()
+	:
+	count(0)
+{
+	for (std::atomic<Block*>& block : blocks)
+		block.store(nullptr, std::memory_order_relaxed);
+}
+
+ChannelTable::~ChannelTable()
+{
+	for (std::atomic<Block*>& block : blocks)
+		delete block.load();
+}
+
+int ChannelTable::open(size_t capacity)
+{
+	std::lock_guard<std::mutex> lock(openLock);
+	size_t index = count.load(std::memory_order_relaxed);
+	if (index == BlockSize * MaxBlocks)
+		throw runtime_error(u8"Es knnen keine weiteren Kanle geffnet werden!");
+
+	Block* block = blocks[index / BlockSize].load(std::memory_order_relaxed);
+	if (block == nullptr)
+	{
+		block = new Block();
+		blocks[index / BlockSize].store(block, std::memory_order_relaxed);
+	}
+	(*block)[index % BlockSize] = std::make_unique<Channel>(capacity);
+	count.store(index + 1, std::memory_order_release);
+	return (int)index + 1;
+}
+
+Channel& ChannelTable::get(int id)
+{
+	if (id < 1 || (size_t)id > count.load(std::memory_order_acquire))
+		throw runtime_error("Es gibt keinen Kanal mit der Nummer " + std::to_string(id) + "!");
+	size_t index = (size_t)id - 1;
+	return *(*blocks[index / BlockSize].load(std::memory_order_relaxed))[index % BlockSize];
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Value.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+//a bounded queue of Values that any number of tasks can send to and receive from at the same time.
+//Sending and receiving is lock free (Dmitry Vyukov's bounded MPMC queue), values are moved in and out so Texte are never copied.
+//Only a thread that has to wait because the channel is full or empty sleeps on a mutex
+class Channel
+{
+public:
+	Channel(size_t capacity); //rounded up to a power of 2
+
+	Channel(const Channel&) = delete;
+	Channel& operator=(const Channel&) = delete;
+
+	bool trySend(Value& value); //move value into the channel, false if it is full. Throws if the channel is closed
+	bool tryReceive(Value& value); //move the oldest value out of the channel, false if it is empty
+	void send(Value& value); //like trySend, but wait while the channel is full. Throws if the channel is closed
+	bool receive(Value& value); //like tryReceive, but wait while the channel is empty. false if the channel is closed and empty
+	bool atEnd(); //wait until the channel has a value or is closed, true if it is closed and empty
+	void close(); //no more values can be sent, the ones in the channel can still be received
+private:
+	//trySend and tryReceive without waking sleepers, so they can be used while mutex is held
+	bool push(Value& value);
+	bool pop(Value& value);
+	template<typename Ready>
+	void waitUntil(Ready ready); //spin for a while, then sleep until ready returns true
+	void wakeSleepers(); //called after every change, only takes the mutex if a thread sleeps
+	bool hasValue() const;
+
+	struct Cell
+	{
+		std::atomic<size_t> sequence; //tells senders and receivers whose turn it is to use value
+		Value value;
+	};
+
+	static constexpr int SpinCount = 64;
+
+	std::unique_ptr<Cell[]> cells;
+	const size_t mask;
+	//on their own cache lines, senders and receivers would slow each other down otherwise
+	alignas(64) std::atomic<size_t> sendPos;
+	alignas(64) std::atomic<size_t> receivePos;
+	alignas(64) std::atomic<bool> closed;
+	std::atomic<int> sleepers;
+	std::mutex mutex;
+	std::condition_variable changed;
+};
+
+//the channels of a program mapped to the number the program knows them by.
+//Channels are never removed, so looking one up takes no lock and sending stays lock free
+class ChannelTable
+{
+public:
+	ChannelTable();
+	~ChannelTable();
+
+	ChannelTable(const ChannelTable&) = delete;
+	ChannelTable& operator=(const ChannelTable&) = delete;
+
+	int open(size_t capacity); //create a new channel and return its number
+	Channel& get(int id); //throws if there is no channel with the number id
+private:
+	static constexpr size_t BlockSize = 1024;
+	static constexpr size_t MaxBlocks = 1024;
+	using Block = std::array<std::unique_ptr<Channel>, BlockSize>;
+
+	std::array<std::atomic<Block*>, MaxBlocks> blocks; //allocated when the first channel in them is opened
+	std::atomic<size_t> count; //the number of opened channels, published after the channel itself
+	std::mutex openLock;
+};
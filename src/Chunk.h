@@ -55,6 +55,25 @@ enum class OpCode
 	GET_ARRAY_ELEMENT,
 	SET_ARRAY_ELEMENT_LOCAL,
 	GET_ARRAY_ELEMENT_LOCAL,
+	APPEND, //append the element or array on the stack to a global array and push the array ('arr sind arr plus x'), in place if the flag after the operands is 0, else to a copy
+	APPEND_LOCAL,
+	APPEND_STRING, //append the value on the stack to a global Text in place ('text ist text plus x'), pushes nothing useful
+	APPEND_STRING_LOCAL,
+	SLICE, //push a copy of the elements start to end (both included) of a global array ('arr von a bis b'), end is on top of the stack
+	SLICE_LOCAL,
+	SET_MATRIX_ELEMENT, //like SET_ARRAY_ELEMENT, with the row and column on the stack
+	GET_MATRIX_ELEMENT,
+	SET_MATRIX_ELEMENT_LOCAL,
+	GET_MATRIX_ELEMENT_LOCAL,
+	SET_DICT_ELEMENT, //like SET_ARRAY_ELEMENT, with the key of a Woerterbuch instead of the index
+	GET_DICT_ELEMENT, //followed by the type the value is expected to have
+	SET_DICT_ELEMENT_LOCAL,
+	GET_DICT_ELEMENT_LOCAL,
+	REMOVE_KEY, //remove the key on the stack from a global Woerterbuch
+	REMOVE_KEY_LOCAL,
+	CONTAINS_KEY, //pop a key and a Woerterbuch and push if it contains the key
+	DICTIONARY_KEYS, //replace the Woerterbuch on the stack by an array of its keys, followed by the type the keys must have
+	NEXT_KEY, //set the loop variable of a fuer jeden loop to the next key of its hidden array and push false once there is none
 	GET_GLOBAL,
 	SET_GLOBAL,
 	GET_LOCAL,
@@ -65,7 +84,14 @@ enum class OpCode
 	POP, // pop the top of the value stack
 	FORPREP,
 	FORDONE,
+	FOR_CONDITION, //check the counter of a fuer loop against its end, counting up or down depending on the first check
+	PARALLEL_FOR, //run the following body for a range of the loop variable on all cores
+	PARALLEL_END, //end of one iteration of a parallel fuer body
+	CHECK_GLOBAL_WRITE, //error if a function called from a parallel fuer body is about to change a global array, put before Anhaengen and Entfernen
 	CALL,
+	START_TASK, //like CALL, but runs the function as a task and pushes the number of the task
+	AWAIT, //wait for the task whose number is on the stack and push its result
+	RECEIVE, //take the next value out of the channel whose number is on the stack, waiting while it is empty
 	RETURN,
 #ifndef NDEBUG
 	PRINT,
@@ -7,22 +7,26 @@
 Compiler::Compiler(const std::string& filePath,
 	std::unordered_map<std::string, Value>* globals,
 	std::unordered_map<std::string, Function>* functions, 
-	std::unordered_map<std::string, Value::Struct>* structs)
+	std::unordered_map<std::string, Value::Struct>* structs,
+	bool eager)
 	:
 	filePath(filePath),
 	runtimeGlobals(globals),
 	functions(functions),
 	runtimeStructs(structs),
+	eager(eager),
 	hadError(false),
 	panicMode(false),
 	currentScopeUnit(nullptr),
-	lastEmittedType(ValueType(Type::None))
+	lastEmittedType(ValueType(Type::None)),
+	parallelLoop(nullptr),
+	startsTasks(false)
 {}
 
 bool Compiler::compile()
 {
 	{
-		Scanner scanner(filePath);
+		Scanner scanner(filePath, &sources);
 		auto result = scanner.scanTokens();
 		if (!result.second) hadError = true;
 		tokens = std::move(result.first);
@@ -45,14 +49,72 @@ bool Compiler::compile()
 	emitReturn();
 
 	mainUnit.endUnit(currentScopeUnit);
-
 	functions->insert(std::make_pair("", std::move(mainFunction)));
 
+	if (eager)
+	{
+		//in the order they were declared, so the errors come in the order of the source
+		std::vector<std::pair<std::vector<Token>::iterator, std::string>> bodies;
+		for (auto& [name, body] : lazyBodies)
+			bodies.emplace_back(body, name);
+		std::sort(bodies.begin(), bodies.end());
+		for (auto& body : bodies)
+			(void)compileFunction(body.second);
+	}
+	patchGlobalAppends();
+
 	finishCompilation();
 
 	return !hadError;
 }
 
+bool Compiler::compileFunction(const std::string& name)
+{
+	auto body = lazyBodies.find(name);
+	if (body == lazyBodies.end()) return !hadError;
+
+	//this may run in the middle of compiling a call to the function, which goes on afterwards
+	auto savedIt = currIt, savedPreIt = preIt;
+	ScopeUnit* savedUnit = currentScopeUnit;
+	ParallelLoop* savedLoop = parallelLoop;
+	auto savedReads = std::move(referenceReads);
+	ValueType savedType = lastEmittedType;
+	std::string savedFuncName = calledFuncName;
+	bool savedPanic = panicMode;
+	parallelLoop = nullptr;
+	referenceReads.clear();
+
+	Function& function = functions->at(name);
+	ScopeUnit globalUnit(nullptr, &function); //stands in for the main scopeUnit of compile()
+	ScopeUnit unit(&globalUnit, &function);
+	unit.identifier = function.argUnit; //the arguments are already stored under this unit
+	for (auto& arg : function.args)
+		unit.locals.insert(arg);
+	function.locals.erase(unit.identifier); //endUnit adds them again, together with the locals of the body
+	currentScopeUnit = &unit;
+
+	panicMode = false;
+	currIt = body->second;
+	preIt = currIt - 1;
+	lazyBodies.erase(body);
+
+	functionBody(function);
+
+	unit.endUnit(currentScopeUnit);
+	patchGlobalAppends();
+	function.lazyCompiler = nullptr;
+
+	currIt = savedIt;
+	preIt = savedPreIt;
+	currentScopeUnit = savedUnit;
+	parallelLoop = savedLoop;
+	referenceReads = std::move(savedReads);
+	lastEmittedType = savedType;
+	calledFuncName = savedFuncName;
+	panicMode = savedPanic;
+	return !hadError;
+}
+
 void Compiler::finishCompilation()
 {
 	for (auto it = globals.begin(), end = globals.end(); it != end; it++)
@@ -89,6 +151,9 @@ Value Compiler::GetDefaultValue(ValueType type)
 	case Type::CharArr: return Value(std::vector<short>());
 	case Type::StringArr: return Value(std::vector<std::string>());
 	case Type::StructArr: return Value(std::vector<Value::Struct>(1, Value::Struct{std::unordered_map<std::string, Value>(), type.structIdentifier}));
+	case Type::Bytes: return Value(std::vector<uint8_t>());
+	case Type::Matrix: return Value(Value::Matrix{ 0, 0, std::vector<double>() });
+	case Type::Dictionary: return Value(Dictionary());
 	}
 	return Value();
 }
@@ -101,15 +166,42 @@ void Compiler::makeNatives()
 	addNative("schreibeZeile", Type::None, { ty::Any }, &Natives::schreibeZeileNative);
 	addNative("lese", Type::Char, {}, &Natives::leseNative);
 	addNative("leseZeile", Type::String, {}, &Natives::leseZeileNative);
+	addNative("leseAlleZeilen", Type::StringArr, {}, &Natives::leseAlleZeilenNative);
+	addNative("leseZeilen", Type::StringArr, { ty::Int }, &Natives::leseZeilenNative);
+	addNative("leseAlleZahlen", Type::IntArr, {}, &Natives::leseAlleZahlenNative);
+	addNative("leseAlleKommazahlen", Type::DoubleArr, {}, &Natives::leseAlleKommazahlenNative);
+	addNative("leerePuffer", Type::None, {}, &Natives::leerePufferNative);
 
 	addNative("existiertDatei", Type::Bool, { ty::String }, &Natives::existiertDateiNative);
 	addNative("leseDatei", Type::String, { ty::String }, &Natives::leseDateiNative);
 	addNative("schreibeDatei", Type::None, { ty::String, ty::Any }, &Natives::schreibeDateiNative);
 	addNative("bearbeiteDatei", Type::None, { ty::String, ty::Any }, &Natives::bearbeiteDateiNative);
+	addNative(u8"schließeDatei", Type::None, { ty::String }, &Natives::schliesseDateiNative);
+	addNative("schliesseDatei", Type::None, { ty::String }, &Natives::schliesseDateiNative);
 
 	addNative("leseBytes", Type::IntArr, { ty::String }, &Natives::leseBytesNative);
-	addNative("schreibeBytes", Type::None, { ty::String, ty::IntArr }, &Natives::schreibeBytesNative);
-	addNative("bearbeiteBytes", Type::None, { ty::String, ty::IntArr }, &Natives::bearbeiteBytesNative);
+	addNative("leseBytesBereich", Type::IntArr, { ty::String, (ty)(ty::Int | ty::Double), ty::Int }, &Natives::leseBytesBereichNative);
+	addNative(u8"leseBinär", Type::Bytes, { ty::String }, &Natives::leseBinaerNative);
+	addNative("leseBinaer", Type::Bytes, { ty::String }, &Natives::leseBinaerNative);
+	addNative(u8"leseBinärBereich", Type::Bytes, { ty::String, (ty)(ty::Int | ty::Double), ty::Int }, &Natives::leseBinaerBereichNative);
+	addNative("leseBinaerBereich", Type::Bytes, { ty::String, (ty)(ty::Int | ty::Double), ty::Int }, &Natives::leseBinaerBereichNative);
+	addNative("schreibeBytes", Type::None, { ty::String, (ty)(ty::IntArr | ty::Bytes) }, &Natives::schreibeBytesNative);
+	addNative("bearbeiteBytes", Type::None, { ty::String, (ty)(ty::IntArr | ty::Bytes) }, &Natives::bearbeiteBytesNative);
+
+	addNative(u8"öffneZeilenLeser", Type::Int, { ty::String }, &Natives::oeffneZeilenLeserNative);
+	addNative("oeffneZeilenLeser", Type::Int, { ty::String }, &Natives::oeffneZeilenLeserNative);
+	addNative(u8"nächsteZeile", Type::String, { ty::Int }, &Natives::naechsteZeileNative);
+	addNative("naechsteZeile", Type::String, { ty::Int }, &Natives::naechsteZeileNative);
+	addNative("istAmEnde", Type::Bool, { ty::Int }, &Natives::istAmEndeNative);
+	addNative(u8"schließeZeilenLeser", Type::None, { ty::Int }, &Natives::schliesseZeilenLeserNative);
+	addNative("schliesseZeilenLeser", Type::None, { ty::Int }, &Natives::schliesseZeilenLeserNative);
+
+	addNative(u8"öffneKanal", Type::Int, { ty::Int }, &Natives::oeffneKanalNative);
+	addNative("oeffneKanal", Type::Int, { ty::Int }, &Natives::oeffneKanalNative);
+	addNative("sende", Type::None, { ty::Int, ty::Any }, &Natives::sendeNative, Function::NativeReturn::Declared, Function::ArgUse::Keeps);
+	addNative(u8"schließeKanal", Type::None, { ty::Int }, &Natives::schliesseKanalNative);
+	addNative("schliesseKanal", Type::None, { ty::Int }, &Natives::schliesseKanalNative);
+	addNative("istKanalAmEnde", Type::Bool, { ty::Int }, &Natives::istKanalAmEndeNative);
 
 	addNative("clock", Type::Double, {}, &Natives::clockNative);
 	addNative("warte", Type::None, { ty::Double }, &Natives::warteNative);
@@ -119,16 +211,22 @@ void Compiler::makeNatives()
 	addNative("zuBoolean", Type::Bool, { (ty)(ty::Int | ty::Double | ty::Bool | ty::Char | ty::String) }, &Natives::zuBooleanNative);
 	addNative("zuBuchstabe", Type::Char, { (ty)(ty::Int | ty::Double | ty::Bool | ty::Char | ty::String) }, &Natives::zuBuchstabeNative);
 	addNative("zuText", Type::String, { ty::Any }, &Natives::zuTextNative);
+	addNative("zuZahlen", Type::IntArr, { (ty)(ty::StringArr | ty::Bytes) }, &Natives::zuZahlenNative);
+	addNative("zuKommazahlen", Type::DoubleArr, { (ty)(ty::StringArr | ty::Matrix) }, &Natives::zuKommazahlenNative);
+	addNative("zuBytes", Type::Bytes, { ty::IntArr }, &Natives::zuBytesNative);
 
-	addNative(u8"Länge", Type::Int, { (ty)(ty::String | ty::IntArr | ty::DoubleArr | ty::BoolArr | ty::CharArr | ty::StringArr) }, &Natives::LaengeNative);
+	constexpr ty arrays = (ty)(ty::IntArr | ty::DoubleArr | ty::BoolArr | ty::CharArr | ty::StringArr | ty::StructArr | ty::Bytes);
+	addNative(u8"Länge", Type::Int, { (ty)(ty::String | arrays | ty::Dictionary) }, &Natives::LaengeNative);
 
 	addNative("Zuschneiden", Type::String, { ty::String, ty::Int, ty::Int }, &Natives::ZuschneidenNative);
 	addNative("Spalten", Type::StringArr, { ty::String, (ty)(ty::String | ty::Char) }, &Natives::SpaltenNative);
 	addNative("Ersetzen", Type::String, { ty::String, (ty)(ty::String | ty::Char), (ty)(ty::String | ty::Char) }, &Natives::ErsetzenNative);
-	addNative("Entfernen", Type::String, { ty::String, ty::Int, ty::Int }, &Natives::EntfernenNative);
+	addNative("Entfernen", Type::Any, { (ty)(ty::String | arrays), ty::Int, ty::Int }, &Natives::EntfernenNative, Function::NativeReturn::FirstArg, Function::ArgUse::ChangesFirst);
 	addNative(u8"Einfügen", Type::String, { ty::String, ty::Int, ty::String }, &Natives::EinfügenNative);
 	addNative(u8"Enthält", Type::Bool, { ty::String, (ty)(ty::String | ty::Char) }, &Natives::EnthältNative);
 	addNative("Beschneiden", Type::String, { ty::String }, &Natives::BeschneidenNative);
+	addNative(u8"Anhängen", Type::Any, { arrays, ty::Any }, &Natives::AnhaengenNative, Function::NativeReturn::FirstArg, Function::ArgUse::ChangesFirst);
+	addNative("Anhaengen", Type::Any, { arrays, ty::Any }, &Natives::AnhaengenNative, Function::NativeReturn::FirstArg, Function::ArgUse::ChangesFirst);
 
 	addNative("Max", Type::Double, { (ty)(ty::Double | ty::Int), (ty)(ty::Double | ty::Int) }, &Natives::Max);
 	addNative("Min", Type::Double, { (ty)(ty::Double | ty::Int), (ty)(ty::Double | ty::Int) }, &Natives::Min);
@@ -142,13 +240,55 @@ void Compiler::makeNatives()
 	addNative(u8"ZufaelligeZahl", Type::Int, { ty::Int, ty::Int }, &Natives::ZufaelligeZahlNative);
 	addNative(u8"ZufälligeKommazahl", Type::Double, { ty::Double, ty::Double }, &Natives::ZufaelligeKommazahlNative);
 	addNative(u8"ZufaelligeKommazahl", Type::Double, { ty::Double, ty::Double }, &Natives::ZufaelligeKommazahlNative);
+	addNative(u8"ZufälligeZahlen", Type::IntArr, { ty::Int, ty::Int, ty::Int }, &Natives::ZufaelligeZahlenNative);
+	addNative(u8"ZufaelligeZahlen", Type::IntArr, { ty::Int, ty::Int, ty::Int }, &Natives::ZufaelligeZahlenNative);
+	addNative(u8"ZufälligeKommazahlen", Type::DoubleArr, { ty::Int, ty::Double, ty::Double }, &Natives::ZufaelligeKommazahlenNative);
+	addNative(u8"ZufaelligeKommazahlen", Type::DoubleArr, { ty::Int, ty::Double, ty::Double }, &Natives::ZufaelligeKommazahlenNative);
+
+	constexpr ty sortable = (ty)(ty::IntArr | ty::DoubleArr | ty::StringArr);
+	constexpr ty element = (ty)(ty::Int | ty::Double | ty::String);
+	using ret = Function::NativeReturn;
+	addNative("Sortiere", Type::Any, { sortable }, &Natives::SortiereNative, ret::FirstArg);
+	addNative("Summe", Type::Any, { (ty)(ty::IntArr | ty::DoubleArr) }, &Natives::SummeNative, ret::FirstArgElement);
+	addNative("Minimum", Type::Any, { sortable }, &Natives::MinimumNative, ret::FirstArgElement);
+	addNative("Maximum", Type::Any, { sortable }, &Natives::MaximumNative, ret::FirstArgElement);
+	addNative("Finde", Type::Int, { sortable, element }, &Natives::FindeNative);
+	addNative(u8"BinärSuche", Type::Int, { sortable, element }, &Natives::BinaerSucheNative);
+	addNative("BinaerSuche", Type::Int, { sortable, element }, &Natives::BinaerSucheNative);
+
+	constexpr ty number = (ty)(ty::Double | ty::Int);
+	addNative("Addiere", Type::DoubleArr, { ty::DoubleArr, ty::DoubleArr }, &Natives::AddiereNative);
+	addNative("Multipliziere", Type::DoubleArr, { ty::DoubleArr, ty::DoubleArr }, &Natives::MultipliziereNative);
+	addNative("Skaliere", Type::DoubleArr, { ty::DoubleArr, number }, &Natives::SkaliereNative);
+	addNative("SkaliereAddiere", Type::DoubleArr, { number, ty::DoubleArr, ty::DoubleArr }, &Natives::SkaliereAddiereNative);
+	addNative("Skalarprodukt", Type::Double, { ty::DoubleArr, ty::DoubleArr }, &Natives::SkalarproduktNative);
+	addNative("Sinuswerte", Type::DoubleArr, { ty::DoubleArr }, &Natives::SinuswerteNative);
+	addNative("Kosinuswerte", Type::DoubleArr, { ty::DoubleArr }, &Natives::KosinuswerteNative);
+	addNative("Exponentialwerte", Type::DoubleArr, { ty::DoubleArr }, &Natives::ExponentialwerteNative);
+	addNative("Logarithmen", Type::DoubleArr, { ty::DoubleArr }, &Natives::LogarithmenNative);
+
+	addNative("NeueMatrix", Type::Matrix, { ty::Int, ty::Int }, &Natives::NeueMatrixNative);
+	addNative("Einheitsmatrix", Type::Matrix, { ty::Int }, &Natives::EinheitsmatrixNative);
+	addNative("zuMatrix", Type::Matrix, { ty::DoubleArr, ty::Int }, &Natives::zuMatrixNative);
+	addNative("Zeilenanzahl", Type::Int, { ty::Matrix }, &Natives::ZeilenanzahlNative);
+	addNative("Spaltenanzahl", Type::Int, { ty::Matrix }, &Natives::SpaltenanzahlNative);
+	addNative("Zeile", Type::DoubleArr, { ty::Matrix, ty::Int }, &Natives::ZeileNative);
+	addNative("Spalte", Type::DoubleArr, { ty::Matrix, ty::Int }, &Natives::SpalteNative);
+	addNative("Transponiere", Type::Matrix, { ty::Matrix }, &Natives::TransponiereNative);
+	addNative("Matrixprodukt", Type::Matrix, { ty::Matrix, ty::Matrix }, &Natives::MatrixproduktNative);
+
+	addNative(u8"NeuesWörterbuch", Type::Dictionary, {}, &Natives::NeuesWoerterbuchNative);
+	addNative(u8"NeuesWoerterbuch", Type::Dictionary, {}, &Natives::NeuesWoerterbuchNative);
 }
 
-void Compiler::addNative(std::string name, Type returnType, std::vector<Natives::CombineableValueType> args, Function::NativePtr native)
+void Compiler::addNative(std::string name, Type returnType, std::vector<Natives::CombineableValueType> args, Function::NativePtr native,
+	Function::NativeReturn nativeReturn, Function::ArgUse argUse)
 {
 	Function func;
 	func.returnType = ValueType(returnType);
 	func.native = native;
+	func.nativeReturn = nativeReturn;
+	func.argUse = argUse;
 	for (int i = 0; i < args.size(); i++)
 		func.args.push_back(std::make_pair("", ValueType(Type::None)));
 	func.nativeArgs = std::move(args);
@@ -198,7 +338,7 @@ void Compiler::advance()
 		if (currIt == tokens.end()) currIt--;
 		if (currIt->type != TokenType::ERROR) break;
 
-		error(currIt->literal, currIt);
+		error(std::string(currIt->literal), currIt);
 	}
 }
 
@@ -242,37 +382,43 @@ ValueType Compiler::expression()
 ValueType Compiler::parsePrecedence(Precedence precedence)
 {
 	advance();
-	MemFunctPtr prefix = parseRules.at(preIt->type).prefix;
+	MemFunctPtr prefix = getRule(preIt->type).prefix;
 	if (prefix == nullptr)
 	{
-		error(u8"Das Token '" + preIt->literal + "' ist kein prefix Operator!");
+		error(u8"Das Token '" + std::string(preIt->literal) + "' ist kein prefix Operator!");
 		return ValueType(Type::None);
 	}
 
 	bool canAssign = precedence <= Precedence::Assignement;
+	size_t readsStart = referenceReads.size();
 	ValueType expr = (this->*prefix)(canAssign);
+	if (!sharesData(expr))
+		referenceReads.resize(readsStart);
 
-	while (precedence <= parseRules.at(currIt->type).precedence)
+	while (precedence <= getRule(currIt->type).precedence)
 	{
 		advance();
-		MemFunctPtr infix = parseRules.at(preIt->type).infix;
+		MemFunctPtr infix = getRule(preIt->type).infix;
 		if (infix == nullptr)
 		{
-			error(u8"Das Token '" + preIt->literal + "' ist kein infix Operator!");
+			error(u8"Das Token '" + std::string(preIt->literal) + "' ist kein infix Operator!");
 			return ValueType(Type::None);
 		}
-		if (infix == parseRules.at(TokenType::LEFT_PAREN).infix && expr.type != Type::Function)
+		if (infix == getRule(TokenType::LEFT_PAREN).infix && expr.type != Type::Function)
 		{
 			error(u8"Du kannst nur Funktionen aufrufen!");
 			return ValueType(Type::None);
 		}
-		else if (infix == parseRules.at(TokenType::LEFT_CURLY).infix && expr.type != Type::Struct)
+		else if (infix == getRule(TokenType::LEFT_CURLY).infix && expr.type != Type::Struct)
 		{
 			error(u8"Du kannst nur den Konstruktor von Strukturen aufrufen!");
 			return ValueType(Type::None);
 		}
 		expr = (this->*infix)(false);
 		lastEmittedType = expr;
+		//an operator makes a new value, only a call or a struct literal can give back the data of its operands
+		if (!sharesData(expr) || (infix != getRule(TokenType::LEFT_PAREN).infix && infix != getRule(TokenType::LEFT_CURLY).infix))
+			referenceReads.resize(readsStart);
 	}
 
 	if (canAssign && match(TokenType::IST))
@@ -283,16 +429,19 @@ ValueType Compiler::parsePrecedence(Precedence precedence)
 
 ValueType Compiler::dnumber(bool canAssign)
 {
-	std::string str(preIt->literal);
-	std::replace(str.begin(), str.end(), ',', '.');
-	double value = std::stod(str);
+	double value = 0;
+	if (!Value::ParseDouble(preIt->literal, value))
+		error(u8"Die Kommazahl ist zu groß!");
 	emitConstant(Value(value));
 	return ValueType(Type::Double);
 }
 
 ValueType Compiler::inumber(bool canAssign)
 {
-	emitConstant(Value(std::stoi(preIt->literal)));
+	int value = 0;
+	if (!Value::ParseInt(preIt->literal, value))
+		error(u8"Die Zahl ist zu groß!");
+	emitConstant(Value(value));
 	return ValueType(Type::Int);
 }
 
@@ -355,7 +504,7 @@ ValueType Compiler::structLiteral(bool canAssign)
 	while(true)
 	{
 		consume(TokenType::IDENTIFIER, "Es wurde ein Feld-Name erwartet!");
-		std::string fieldName = preIt->literal;
+		std::string fieldName(preIt->literal);
 		if (fieldName == structName)
 			error(u8"Eine Struktur kann sich nicht selbst als Feld haben!");
 		emitConstant(Value(fieldName));
@@ -507,7 +656,7 @@ ValueType Compiler::binary(bool canAssign)
 {
 	TokenType operatorType = preIt->type;
 	ValueType lhs = lastEmittedType;
-	ParseRule rule = parseRules.at(operatorType);
+	ParseRule rule = getRule(operatorType);
 	ValueType expr = parsePrecedence((Precedence)((int)rule.precedence + 1));
 
 	switch (operatorType)
@@ -516,7 +665,7 @@ ValueType Compiler::binary(bool canAssign)
 	{
 		if (isArr(lhs))
 		{
-			ValueType elementType = (Type)((int)lhs.type - 6);
+			ValueType elementType = ::elementType(lhs.type);
 			if (expr != elementType && expr != lhs)
 				error(u8"Du kannst Arrays nur elemente oder andere Arrays desselben Typs hinzufügen!");
 
@@ -745,6 +894,56 @@ std::pair<int, ValueType> Compiler::getLocal(std::string name)
 	return std::make_pair(-1, Type::None);
 }
 
+bool Compiler::isSlice(const std::string& varName)
+{
+	auto typeOf = [this](const std::string& name) {
+		auto pair = getLocal(name);
+		if (pair.first != -1)
+			return pair.second;
+		return globals.count(name) == 1 ? globals.at(name) : ValueType(Type::None);
+	};
+	if (!isArr(typeOf(varName)))
+		return false;
+	//a member of a struct may have the name of an array, then 'x von y' still reads the member
+	if (checkNext(TokenType::IDENTIFIER) && typeOf(std::string((currIt + 1)->literal)).type == Type::Struct)
+		return false;
+	//'x von y von z' is a member chain even if y is no variable, so it is only a slice if the 'bis' comes before the next 'von'
+	int depth = 0;
+	for (auto it = currIt + 1; it != tokens.end(); it++)
+	{
+		switch (it->type)
+		{
+		case TokenType::LEFT_PAREN:
+		case TokenType::LEFT_SQAREBRACKET:
+			depth++;
+			break;
+		case TokenType::RIGHT_PAREN:
+		case TokenType::RIGHT_SQAREBRACKET:
+			if (--depth < 0)
+				return false;
+			break;
+		case TokenType::VON:
+			if (depth == 0)
+				return false;
+			break;
+		case TokenType::BIS:
+			if (depth == 0)
+				return true;
+			break;
+		case TokenType::DOT:
+		case TokenType::COMMA:
+		case TokenType::COLON:
+		case TokenType::END:
+			if (depth == 0)
+				return false;
+			break;
+		default:
+			break;
+		}
+	}
+	return false;
+}
+
 ValueType Compiler::memberAccess(bool canAssign, std::string memberName)
 {
 	std::vector<std::string> member; //chain of members like x von y von z where x is memberName and y and z will be in member
@@ -752,10 +951,10 @@ ValueType Compiler::memberAccess(bool canAssign, std::string memberName)
 	{
 		if (!match(TokenType::IDENTIFIER))
 		{
-			error(u8"Das Token '" + currIt->literal + "' ist kein Struktur identifizierer!");
+			error(u8"Das Token '" + std::string(currIt->literal) + "' ist kein Struktur identifizierer!");
 			return ValueType(Type::None);
 		}
-		member.push_back(preIt->literal);
+		member.emplace_back(preIt->literal);
 	} while (match(TokenType::VON));
 
 	std::string varName = member.back();
@@ -818,6 +1017,7 @@ ValueType Compiler::memberAccess(bool canAssign, std::string memberName)
 			emitShort(makeConstant(*it));
 	};
 
+	size_t readsStart = referenceReads.size();
 	if (canAssign && match(TokenType::IST))
 	{
 		ValueType expr = Type::None;
@@ -829,6 +1029,8 @@ ValueType Compiler::memberAccess(bool canAssign, std::string memberName)
 			expr = expression();
 		if (expr != lastType)
 			error(u8"Falscher Zuweisungs Typ!");
+		checkParallelWrite(local, varName);
+		assignReads(readsStart, local, varName);
 		emitGetSet(setOp);
 	}
 	else if (canAssign && match(TokenType::SIND))
@@ -838,6 +1040,8 @@ ValueType Compiler::memberAccess(bool canAssign, std::string memberName)
 		ValueType expr = expression();
 		if (expr != lastType)
 			error(u8"Falscher Zuweisungs Typ!");
+		checkParallelWrite(local, varName);
+		assignReads(readsStart, local, varName);
 		emitGetSet(setOp);
 	}
 	else if (match(TokenType::AN))
@@ -845,9 +1049,12 @@ ValueType Compiler::memberAccess(bool canAssign, std::string memberName)
 		if (type.type != Type::StructArr)
 			error("'" + varName + "' ist kein Strukturen Array!");
 
+		size_t indexStart = currentChunk()->bytes.size();
 		ValueType expr = parsePrecedence(Precedence::Indexing);
 		if (expr.type != Type::Int)
 			error(u8"Du kannst nur ganze Zahlen zum indexieren benutzen!");
+		bool indexIsCounter = isParallelCounter(indexStart);
+		readsStart = referenceReads.size();
 
 		if (canAssign && match(TokenType::IST))
 		{
@@ -856,6 +1063,8 @@ ValueType Compiler::memberAccess(bool canAssign, std::string memberName)
 			ValueType expr = expression();
 			if (expr != lastType)
 				error(u8"Falscher Zuweisungs Typ!");
+			checkParallelElementWrite(local, varName, indexIsCounter, Type::Struct);
+			assignReads(readsStart, local, varName);
 
 			emitByte(local != -1 ? op::SET_MEMBER_ARRAY_LOCAL : op::SET_MEMBER_ARRAY_GLOBAL); emitShort(makeConstant(varName));
 			if (local != -1)
@@ -874,6 +1083,8 @@ ValueType Compiler::memberAccess(bool canAssign, std::string memberName)
 			ValueType expr = expression();
 			if (expr != lastType)
 				error(u8"Falscher Zuweisungs Typ!");
+			checkParallelElementWrite(local, varName, indexIsCounter, Type::Struct);
+			assignReads(readsStart, local, varName);
 
 			emitByte(local != -1 ? op::SET_MEMBER_ARRAY_LOCAL : op::SET_MEMBER_ARRAY_GLOBAL); emitShort(makeConstant(varName));
 			if (local != -1)
@@ -887,6 +1098,7 @@ ValueType Compiler::memberAccess(bool canAssign, std::string memberName)
 		}
 		else
 		{
+			referenceReads.emplace_back(local, varName);
 			emitByte(local != -1 ? op::GET_MEMBER_ARRAY_LOCAL : op::GET_MEMBER_ARRAY_GLOBAL); emitShort(makeConstant(varName));
 			if (local != -1)
 				emitShort(makeConstant(local));
@@ -900,6 +1112,7 @@ ValueType Compiler::memberAccess(bool canAssign, std::string memberName)
 	}
 	else
 	{
+		referenceReads.emplace_back(local, varName);
 		emitGetSet(getOp);
 	}
 	lastEmittedType = lastType;
@@ -908,8 +1121,8 @@ ValueType Compiler::memberAccess(bool canAssign, std::string memberName)
 
 ValueType Compiler::variable(bool canAssign)
 {
-	std::string varName = preIt->literal;
-	if (currIt->type == TokenType::VON)
+	std::string varName(preIt->literal);
+	if (currIt->type == TokenType::VON && !isSlice(varName))
 	{
 		advance(); //set currIt to the second identifier
 		return memberAccess(canAssign, varName);
@@ -950,12 +1163,21 @@ ValueType Compiler::variable(bool canAssign)
 		ValueType expr = Type::None;
 		if (isArr(type))
 			error(u8"Bei einer Array Zuweisung muss 'sind' anstatt 'ist' stehen!");
+		if (type.type == Type::String && check(TokenType::IDENTIFIER) && currIt->literal == varName && checkNext(TokenType::PLUS))
+		{
+			advance();
+			appendToString(varName, local);
+			return type;
+		}
+		size_t readsStart = referenceReads.size();
 		if (type.type == Type::Bool)
 			expr = boolAssignement();
 		else
 			expr = expression();
 		if (expr != type)
 			error(u8"Falscher Zuweisungs Typ!");
+		checkParallelWrite(local, varName);
+		assignReads(readsStart, local, varName);
 		emitByte(setOp); emitShort(makeConstant(varName));
 		if (setOp == op::SET_LOCAL)
 			emitShort(makeConstant(local));
@@ -964,22 +1186,39 @@ ValueType Compiler::variable(bool canAssign)
 	{
 		if (!isArr(type))
 			error(u8"Bei einer Variablen zuweisung muss 'ist' anstatt 'sind' stehen!");
+		if (check(TokenType::IDENTIFIER) && currIt->literal == varName && checkNext(TokenType::PLUS))
+		{
+			advance();
+			appendToArray(varName, type, local);
+			return type;
+		}
+		size_t readsStart = referenceReads.size();
 		ValueType expr = expression();
 		if (expr != type)
 			error(u8"Falscher Zuweisungs Typ!");
+		checkParallelWrite(local, varName);
+		assignReads(readsStart, local, varName);
 		emitByte(setOp); emitShort(makeConstant(varName));
 		if (setOp == op::SET_LOCAL)
 			emitShort(makeConstant(local));
 	}
 	else if (match(TokenType::AN))
 	{
-		if (!isArr(type))
-			error(u8"Es können nur Arrays indexiert werden!");
-		index(canAssign, varName, type, local);
+		if (type.type == Type::Dictionary)
+			dictionaryElement(varName, local);
+		else
+		{
+			if (!isArr(type) && type.type != Type::Matrix)
+				error(u8"Es können nur Arrays, Matrizen und Wörterbücher indexiert werden!");
+			index(canAssign, varName, type, local);
+		}
 		type = lastEmittedType;
 	}
+	else if (match(TokenType::VON))
+		slice(varName, local);
 	else
 	{
+		referenceReads.emplace_back(local, varName);
 		emitByte(getOp); emitShort(makeConstant(varName));
 		if (setOp == op::SET_LOCAL)
 			emitShort(makeConstant(local));
@@ -990,17 +1229,32 @@ ValueType Compiler::variable(bool canAssign)
 
 void Compiler::index(bool canAssign, std::string arrName, ValueType type, int local)
 {
+	bool matrix = type.type == Type::Matrix;
 	OpCode getOp = local == -1 ? op::GET_ARRAY_ELEMENT : op::GET_ARRAY_ELEMENT_LOCAL;
 	OpCode setOp = local == -1 ? op::SET_ARRAY_ELEMENT : op::SET_ARRAY_ELEMENT_LOCAL;
+	if (matrix)
+	{
+		getOp = local == -1 ? op::GET_MATRIX_ELEMENT : op::GET_MATRIX_ELEMENT_LOCAL;
+		setOp = local == -1 ? op::SET_MATRIX_ELEMENT : op::SET_MATRIX_ELEMENT_LOCAL;
+	}
 
-	ValueType elementType = (Type)((int)type.type - 6);
+	ValueType elementType = matrix ? Type::Double : ::elementType(type.type);
 
+	size_t indexStart = currentChunk()->bytes.size();
 	ValueType rhs = parsePrecedence(Precedence::Indexing);
+	bool indexIsCounter = isParallelCounter(indexStart); //for a matrix the row, so a parallel für still writes only its own rows
 	if (rhs.type != Type::Int)
 		error(u8"Du kannst nur ganze Zahlen zum indexieren benutzen!");
+	if (matrix)
+	{
+		consume(TokenType::COMMA, u8"Nach der Zeile einer Matrix wurde ein ',' und die Spalte erwartet!");
+		if (parsePrecedence(Precedence::Indexing).type != Type::Int)
+			error(u8"Du kannst nur ganze Zahlen zum indexieren benutzen!");
+	}
 
 	if (match(TokenType::IST))
 	{
+		size_t readsStart = referenceReads.size();
 		ValueType expr = Type::None;
 		if (elementType.type == Type::Bool)
 			expr = boolAssignement();
@@ -1008,30 +1262,168 @@ void Compiler::index(bool canAssign, std::string arrName, ValueType type, int lo
 			expr = expression();
 		if (expr != elementType)
 			error(u8"Falscher Zuweisungs Typ!");
+		checkParallelElementWrite(local, arrName, indexIsCounter, elementType.type);
+		assignReads(readsStart, local, arrName);
 		emitByte(setOp); emitShort(makeConstant(arrName));
-		if (setOp == op::SET_ARRAY_ELEMENT_LOCAL)
+		if (local != -1)
 			emitShort(makeConstant(local));
 	}
 	else
 	{
+		referenceReads.emplace_back(local, arrName); //the element of a Strukturen array shares the fields
 		emitByte(getOp); emitShort(makeConstant(arrName));
-		if (getOp == op::GET_ARRAY_ELEMENT_LOCAL)
+		if (local != -1)
 			emitShort(makeConstant(local));
 	}
 	lastEmittedType = elementType;
 }
 
+void Compiler::slice(const std::string& arrName, int local)
+{
+	//the bounds are parsed like a Term, so 'arr von i plus 1 bis n minus 1' works, but a slice has to be put in parentheses to add something to it
+	if (parsePrecedence(Precedence::Term).type != Type::Int)
+		error(u8"Du kannst nur ganze Zahlen zum indexieren benutzen!");
+	consume(TokenType::BIS, u8"Es wurde ein 'bis' erwartet!");
+	if (parsePrecedence(Precedence::Term).type != Type::Int)
+		error(u8"Du kannst nur ganze Zahlen zum indexieren benutzen!");
+
+	emitByte(local == -1 ? op::SLICE : op::SLICE_LOCAL); emitShort(makeConstant(arrName));
+	if (local != -1)
+		emitShort(makeConstant(local));
+}
+
+void Compiler::dictionaryElement(std::string dictName, int local)
+{
+	checkKeyType(parsePrecedence(Precedence::Indexing));
+
+	if (match(TokenType::IST))
+	{
+		size_t readsStart = referenceReads.size();
+		ValueType expr = expression();
+		if (expr.type == Type::None)
+			error(u8"Falscher Zuweisungs Typ!");
+		checkParallelWrite(local, dictName);
+		assignReads(readsStart, local, dictName);
+		emitByte(local == -1 ? op::SET_DICT_ELEMENT : op::SET_DICT_ELEMENT_LOCAL); emitShort(makeConstant(dictName));
+		if (local != -1)
+			emitShort(makeConstant(local));
+		lastEmittedType = expr;
+		return;
+	}
+
+	//a Wörterbuch can hold values of any type, so the program has to say which one it expects
+	consume(TokenType::ALS, u8"Nach dem Schlüssel eines Wörterbuchs wird 'als' und der erwartete Typ erwartet!");
+	ValueType result = resultType();
+	referenceReads.emplace_back(local, dictName);
+	emitByte(local == -1 ? op::GET_DICT_ELEMENT : op::GET_DICT_ELEMENT_LOCAL); emitShort(makeConstant(dictName));
+	if (local != -1)
+		emitShort(makeConstant(local));
+	emitByte((uint8_t)result.type);
+	lastEmittedType = result;
+}
+
+ValueType Compiler::contains(bool canAssign)
+{
+	if (lastEmittedType.type != Type::Dictionary)
+		error(u8"Nur ein Wörterbuch kann einen Schlüssel enthalten!");
+	checkKeyType(parsePrecedence((Precedence)((int)Precedence::Comparison + 1)));
+	emitByte(op::CONTAINS_KEY);
+	lastEmittedType = Type::Bool;
+	return Type::Bool;
+}
+
+void Compiler::checkKeyType(ValueType key)
+{
+	if (key.type != Type::String && key.type != Type::Int)
+		error(u8"Ein Wörterbuch kann nur Texte und Zahlen als Schlüssel haben!");
+}
+
+void Compiler::appendToArray(const std::string& arrName, ValueType type, int local)
+{
+	//'arr plus x' would copy the whole array just to assign the copy back, so the elements are appended in place
+	checkParallelWrite(local, arrName);
+	ValueType elementType(type.structIdentifier, ::elementType(type.type));
+	while (match(TokenType::PLUS))
+	{
+		size_t readsStart = referenceReads.size();
+		ValueType expr = parsePrecedence((Precedence)((int)Precedence::Term + 1));
+		if (expr != elementType && expr != type)
+			error(u8"Du kannst Arrays nur elemente oder andere Arrays desselben Typs hinzufügen!");
+		if (type.type == Type::StructArr) //the appended structs share their fields, other elements are copied
+			assignReads(readsStart, local, arrName);
+		else
+			referenceReads.resize(readsStart);
+		emitByte(local == -1 ? op::APPEND : op::APPEND_LOCAL); emitShort(makeConstant(arrName));
+		if (local != -1)
+			emitShort(makeConstant(local));
+		//appending in place would change the array of every variable that shares it, so the flag says to copy it until it is known that none does
+		if (local == -1)
+			globalAppends.push_back(GlobalAppend{ currentFunction()->chunk, currentChunk()->bytes.size(), arrName });
+		else
+			unitOf(local)->appends.emplace_back(currentChunk()->bytes.size(), arrName);
+		emitByte(1);
+		if (check(TokenType::PLUS))
+			emitByte(op::POP);
+	}
+	referenceReads.emplace_back(local, arrName);
+	lastEmittedType = type;
+}
+
+void Compiler::appendToString(const std::string& varName, int local)
+{
+	//'text plus x' would copy the whole Text into a new one and then again into the variable, so x is appended in place
+	checkParallelWrite(local, varName);
+	while (match(TokenType::PLUS))
+	{
+		ValueType expr = parsePrecedence((Precedence)((int)Precedence::Term + 1));
+		if (expr.type == Type::Bool)
+			error(u8"Ein Boolean kann kein Operand in einer addition sein");
+		else if (expr.type != Type::Int && expr.type != Type::Double && expr.type != Type::Char && expr.type != Type::String)
+			error(u8"Falscher Zuweisungs Typ!");
+		emitByte(local == -1 ? op::APPEND_STRING : op::APPEND_STRING_LOCAL); emitShort(makeConstant(varName));
+		if (local != -1)
+			emitShort(makeConstant(local));
+		if (check(TokenType::PLUS))
+			emitByte(op::POP);
+	}
+
+	//APPEND_STRING leaves nothing useful on the stack, so only an assignment that is used as a value reads the Text again
+	if (!check(TokenType::DOT))
+	{
+		emitByte(op::POP);
+		emitByte(local == -1 ? op::GET_GLOBAL : op::GET_LOCAL); emitShort(makeConstant(varName));
+		if (local != -1)
+			emitShort(makeConstant(local));
+	}
+	lastEmittedType = Type::String;
+}
+
 ValueType Compiler::call(bool canAssign)
+{
+	return emitCall(op::CALL);
+}
+
+ValueType Compiler::emitCall(OpCode callOp)
 {
 	std::string funcName = calledFuncName;
 	Function* func = &functions->at(funcName);
 
 	int argCount = 0;
+	ValueType firstArg = Type::None;
+	size_t readsStart = referenceReads.size();
+	size_t firstArgEnd = readsStart;
 	if (currIt->type != TokenType::RIGHT_PAREN)
 	{
 		do
 		{
+			size_t argStart = referenceReads.size();
 			ValueType expr = expression();
+			if (argCount == 0) firstArg = expr;
+			if (func->native == nullptr || func->argUse == Function::ArgUse::Keeps)
+				passReads(argStart);
+			if (argCount == 0) firstArgEnd = referenceReads.size();
+			if (argCount == 0 && func->argUse == Function::ArgUse::ChangesFirst && readsOutside(argStart))
+				error(u8"In einer parallelen für Anweisung können nur Arrays verändert werden, die in ihr definiert wurden!");
 			try
 			{
 				if (func->native != nullptr)
@@ -1058,16 +1450,94 @@ ValueType Compiler::call(bool canAssign)
 		error(u8"Zu wenige Argumente beim Funktions Aufruf!");
 	consume(TokenType::RIGHT_PAREN, u8"Es wurde eine ')' beim Funktions Aufruf erwartet!");
 
-	emitByte(op::CALL); emitShort(makeConstant(Value(funcName)));
-	lastEmittedType = func->returnType;
-	return func->returnType;
+	//Anhängen and Entfernen change a global array like an element write does
+	if (func->argUse == Function::ArgUse::ChangesFirst &&
+		std::any_of(referenceReads.begin() + readsStart, referenceReads.begin() + firstArgEnd, [](auto& read) { return read.first == -1; }))
+		emitByte(op::CHECK_GLOBAL_WRITE);
+	emitByte(callOp); emitShort(makeConstant(Value(funcName)));
+
+	//whether the result shares a global is only known from the body
+	if (func->native == nullptr && func->lazyCompiler != nullptr && sharesData(func->returnType))
+	{
+		(void)compileFunction(funcName);
+		func = &functions->at(funcName);
+	}
+	//a native gives back a new value or its first argument, a function may give back any of its arguments or a global
+	if (func->native != nullptr)
+		referenceReads.resize(func->argUse == Function::ArgUse::ChangesFirst ? firstArgEnd : readsStart);
+	else if (func->returnsShared)
+		referenceReads.emplace_back(-1, "");
+
+	ValueType returnType = func->returnType;
+	if (func->nativeReturn == Function::NativeReturn::FirstArg)
+		returnType = firstArg;
+	else if (func->nativeReturn == Function::NativeReturn::FirstArgElement && isArr(firstArg.type))
+		returnType = elementType(firstArg.type);
+	lastEmittedType = returnType;
+	return returnType;
+}
+
+ValueType Compiler::startTask(bool canAssign)
+{
+	consume(TokenType::IDENTIFIER, u8"Nach 'starte' wird ein Funktions-Name erwartet!");
+	calledFuncName = std::string(preIt->literal);
+	if (functions->count(calledFuncName) == 0)
+	{
+		error(u8"Die Funktion '" + calledFuncName + u8"' ist nicht definiert!");
+		return Type::Int;
+	}
+	consume(TokenType::LEFT_PAREN, u8"Nach dem Funktions-Namen wird eine '(' erwartet!");
+	startsTasks = true;
+
+	(void)emitCall(op::START_TASK); //the result is only known when the task is awaited
+	lastEmittedType = Type::Int;
+	return Type::Int;
+}
+
+ValueType Compiler::awaitTask(bool canAssign)
+{
+	ValueType task = parsePrecedence(Precedence::Unary);
+	if (task.type != Type::Int) error(u8"Nach 'erwarte' wird die Nummer einer Aufgabe erwartet!");
+
+	//without 'als' the result is thrown away
+	ValueType result = match(TokenType::ALS) ? resultType() : Type::None;
+
+	emitBytes(op::AWAIT, (uint8_t)result.type);
+	referenceReads.emplace_back(-1, ""); //the task may still hold the result
+	lastEmittedType = result;
+	return result;
+}
+
+ValueType Compiler::receive(bool canAssign)
+{
+	ValueType channel = parsePrecedence(Precedence::Unary);
+	if (channel.type != Type::Int) error(u8"Nach 'empfange' wird die Nummer eines Kanals erwartet!");
+
+	//any value can be sent, so the program has to say what it expects
+	consume(TokenType::ALS, u8"Nach dem Kanal wird 'als' und der erwartete Typ erwartet!");
+	ValueType result = resultType();
+
+	emitBytes(op::RECEIVE, (uint8_t)result.type);
+	referenceReads.emplace_back(-1, ""); //the sender may still hold the value
+	lastEmittedType = result;
+	return result;
+}
+
+ValueType Compiler::resultType()
+{
+	advance();
+	ValueType result = tokenToValueType(preIt->type);
+	if (result.type == Type::None)
+		error(u8"Es wurde ein Typspezifizierer erwartet!");
+	return result;
 }
 
 #pragma endregion
 
 void Compiler::declaration()
 {
-	if (match(TokenType::DER) || match(TokenType::DIE)/* || match(TokenType::DAS) */)
+	referenceReads.clear();
+	if (match(TokenType::DER) || match(TokenType::DIE) || match(TokenType::DAS))
 	{
 		if (preIt->type == TokenType::DIE && match(TokenType::FUNKTION))
 			funDeclaration();
@@ -1102,6 +1572,8 @@ void Compiler::statement()
 		block();
 	else if (match(TokenType::GIB))
 		returnStatement();
+	else if (match(TokenType::ENTFERNE))
+		removeStatement();
 	else
 		expressionStatement();
 }
@@ -1121,11 +1593,12 @@ void Compiler::synchronize()
 		case TokenType::FUNKTION:
 		case TokenType::DER:
 		case TokenType::DIE:
-		//case TokenType::DAS:
+		case TokenType::DAS:
 		case TokenType::FUER:
 		case TokenType::WENN:
 		case TokenType::SOLANGE:
 		case TokenType::GIB:
+		case TokenType::ENTFERNE:
 			return;
 		default:;
 		}
@@ -1224,7 +1697,7 @@ void Compiler::varDeclaration()
 		if (!match(TokenType::ZAHL) && !match(TokenType::KOMMAZAHL) &&
 			!match(TokenType::ZAHLEN) && !match(TokenType::KOMMAZAHLEN) &&
 			!match(TokenType::BUCHSTABEN) && !match(TokenType::TEXTE) &&
-			!match(TokenType::BOOLEANS) && !match(TokenType::STRUKTUR) &&
+			!match(TokenType::BOOLEANS) && !match(TokenType::BYTES) && !match(TokenType::MATRIX) && !match(TokenType::STRUKTUR) &&
 			!match(TokenType::STRUKTUREN))
 		{
 			error(u8"Falscher Artikel!", currIt);
@@ -1233,11 +1706,21 @@ void Compiler::varDeclaration()
 		varType.type = tokenToValueType(preIt->type).type;
 		break;
 	}
+	case TokenType::DAS:
+	{
+		if (!match(TokenType::WOERTERBUCH))
+		{
+			error(u8"Falscher Artikel!", currIt);
+			return;
+		}
+		varType = Type::Dictionary;
+		break;
+	}
 	}
 
 	consume(TokenType::IDENTIFIER, "Es wurde ein Variablen-Name erwartet!");
 
-	std::string varName = preIt->literal;
+	std::string varName(preIt->literal);
 	OpCode defineCode;
 	int unit = -1;
 	if (currentScopeUnit->scopeDepth == 0) //scopeDepth is zero so we are in global scope
@@ -1253,6 +1736,7 @@ void Compiler::varDeclaration()
 	}
 
 	bool stueck = false;
+	size_t readsStart = referenceReads.size();
 	if (match(TokenType::IST))
 	{
 		//if the variable is an Array you must use 'sind' instead of 'ist'
@@ -1285,6 +1769,7 @@ void Compiler::varDeclaration()
 	}
 	else
 		error(u8"Eine Variable muss immer definiert werden!");
+	assignReads(readsStart, unit, varName);
 	consume(TokenType::DOT, u8"Es fehlt ein Punkt nach einer Variablen Definition!");
 
 	emitByte(defineCode); emitShort(makeConstant(Value(varName)));
@@ -1308,6 +1793,9 @@ ValueType Compiler::tokenToValueType(TokenType type)
 	case TokenType::BOOLEANS: return Type::BoolArr;
 	case TokenType::BUCHSTABEN: return Type::CharArr;
 	case TokenType::TEXTE: return Type::StringArr;
+	case TokenType::BYTES: return Type::Bytes;
+	case TokenType::MATRIX: return Type::Matrix;
+	case TokenType::WOERTERBUCH: return Type::Dictionary;
 	case TokenType::STRUKTUR: return Type::Struct;
 	case TokenType::STRUKTUREN: return Type::StructArr;
 	}
@@ -1318,7 +1806,7 @@ void Compiler::funDeclaration()
 {
 	if (currentScopeUnit->scopeDepth > 0) error(u8"Du kannst nur globale Funktionen definieren!");
 	consume(TokenType::IDENTIFIER, u8"Es wurde ein Funktions-Name erwartet!");
-	std::string funcName = preIt->literal;
+	std::string funcName(preIt->literal);
 	if (functions->count(funcName) == 1)
 		error(u8"Eine Funktion mit diesem Namen existiert bereits!");
 	Function function;
@@ -1347,8 +1835,8 @@ void Compiler::funDeclaration()
 				error(u8"Es wurde ein Typ spezifizierer erwartet!");
 			argType.type = tokenToValueType(parameterType).type;
 			consume(TokenType::IDENTIFIER, u8"Es wurde ein Parameter-Name erwartet!");
-			addLocal(preIt->literal, argType);
-			currentFunction()->args.push_back(std::make_pair(preIt->literal, argType));
+			addLocal(std::string(preIt->literal), argType);
+			currentFunction()->args.push_back(std::make_pair(std::string(preIt->literal), argType));
 		} while (match(TokenType::COMMA));
 	}
 
@@ -1376,6 +1864,20 @@ void Compiler::funDeclaration()
 
 	functions->insert(std::make_pair(funcName, function));
 
+	//only the signature is needed to check calls. The body is compiled on the first call, or at the end of compile() with --eager,
+	//so in both modes it sees every function and global
+	lazyBodies[funcName] = currIt;
+	function.lazyCompiler = this;
+	while (currIt->type != TokenType::END && currIt->depth >= currentScopeUnit->scopeDepth)
+		advance();
+
+	unit.endUnit(currentScopeUnit);
+
+	(*functions)[funcName] = std::move(function);
+}
+
+void Compiler::functionBody(Function& function)
+{
 	while (currIt->type != TokenType::END && currIt->depth >= currentScopeUnit->scopeDepth)
 		declaration();
 
@@ -1385,16 +1887,14 @@ void Compiler::funDeclaration()
 		if (function.returnType.type != Type::None)
 			error(u8"Es fehlt eine Rückgabe Anweisung!");
 	}
-
-	unit.endUnit(currentScopeUnit);
-
-	(*functions)[funcName] = std::move(function);
 }
 
 void Compiler::returnStatement()
 {
 	if (currentScopeUnit->scopeDepth == 0)
 		error("In der Hauptfunktion ist keine Rückgabe Anweisung erlaubt!");
+	if (parallelLoop != nullptr)
+		error(u8"In einer parallelen für Anweisung ist keine Rückgabe Anweisung erlaubt!");
 	if (match(TokenType::ZURUECK))
 	{
 		emitReturn();
@@ -1404,9 +1904,19 @@ void Compiler::returnStatement()
 	}
 	else
 	{
+		size_t readsStart = referenceReads.size();
 		ValueType expr = expression();
 		if (expr != currentFunction()->returnType)
 			error(u8"Der Rückgabe Typ stimmt nicht mit dem Rückgabe Typ der Funktion überein!");
+		//the caller knows which arguments it passed, but not which globals the result shares
+		for (auto it = referenceReads.begin() + readsStart; it != referenceReads.end(); it++)
+		{
+			if (it->first == -1 || isShared(it->first, it->second))
+			{
+				markShared(it->first, it->second);
+				currentFunction()->returnsShared = true;
+			}
+		}
 		consume(TokenType::ZURUECK, u8"Es wurde 'zurück' erwartet!");
 		emitReturn();
 		if (currentScopeUnit->scopeDepth == 1) currentFunction()->returned = true;
@@ -1418,7 +1928,7 @@ void Compiler::structDeclaration()
 {
 	if (currentScopeUnit->scopeDepth > 0) error(u8"Du kannst Strukturen nur im globalen Bereich definieren!");
 	consume(TokenType::IDENTIFIER, u8"Es wurde ein Struktur-Name erwartet!");
-	std::string structName = preIt->literal;
+	std::string structName(preIt->literal);
 	if (structs.count(structName) != 0)
 		error("Diese Struktur existiert bereits!");
 	else if (functions->count(structName) != 0)
@@ -1456,10 +1966,11 @@ void Compiler::structDeclaration()
 		fieldType.structIdentifier = structType;
 		advance();
 		consume(TokenType::IDENTIFIER, u8"Es wurde ein Parameter-Name erwartet!");
-		if (stru.count(preIt->literal) != 0)
+		std::string fieldName(preIt->literal);
+		if (stru.count(fieldName) != 0)
 			error("Die Struktur '" + structName + "' hat bereits ein Feld mit diesem Namen!");
-		stru.insert(std::make_pair(preIt->literal, fieldType));
-		emitConstant(Value(preIt->literal));
+		stru.insert(std::make_pair(fieldName, fieldType));
+		emitConstant(Value(fieldName));
 		if (!isArr(fieldType.type)) consume(TokenType::IST, "Es wurde 'ist' erwartet!");
 		else if (isArr(fieldType.type)) consume(TokenType::SIND, "Es wurde 'sind' erwartet!");
 		ValueType expr = fieldType.type == Type::Bool ? boolAssignement() : expression();
@@ -1509,9 +2020,9 @@ void Compiler::ifStatement()
 	statement();
 
 	int elseJump = emitJump(op::JUMP);
-	emitByte(op::POP);
 
-	patchJump(thenJump);
+	patchJump(thenJump); //the condition is still on the stack when it was false
+	emitByte(op::POP);
 
 	if (match(TokenType::SONST))
 		statement();
@@ -1549,15 +2060,35 @@ void Compiler::forStatement()
 	currentScopeUnit = &unit;
 
 	consume(TokenType::JEDE, u8"Nach einem 'für' sollte ein 'jede' stehen!");
+	if (match(TokenType::TEXT))
+	{
+		consume(TokenType::IDENTIFIER, u8"Es wurde ein Variablen-Name erwartet!");
+		forEachStatement(std::string(preIt->literal), Type::String);
+		unit.endUnit(currentScopeUnit);
+		return;
+	}
 	consume(TokenType::ZAHL, u8"Eine fuer Anweisung kann nur durch Zahlen iterieren!");
 
 	consume(TokenType::IDENTIFIER, u8"Es wurde ein Variablen-Name erwartet!");
-	std::string localName = preIt->literal;
+	std::string localName(preIt->literal);
+	if (check(TokenType::IN))
+	{
+		forEachStatement(localName, Type::Int);
+		unit.endUnit(currentScopeUnit);
+		return;
+	}
 	int localNameConstant = makeConstant(localName);
 	uint16_t unitConstant = makeConstant(currentScopeUnit->identifier);
 	addLocal(localName, Type::Int);
 	consume(TokenType::VON, u8"Es wurde ein 'von' erwartet!");
 
+	if (isParallelFor())
+	{
+		parallelForStatement(localName, localNameConstant, unitConstant);
+		unit.endUnit(currentScopeUnit);
+		return;
+	}
+
 	ValueType expr = expression();
 	if (expr.type != Type::Int) error(u8"Eine für Anweisung kann nur durch Zahlen iterieren!");
 
@@ -1570,13 +2101,18 @@ void Compiler::forStatement()
 	emitByte(op::FORPREP);
 	int conditionLoop = static_cast<int>(currentChunk()->bytes.size());
 	
-	emitBytes(op::GET_LOCAL, localNameConstant);
+	emitByte(op::GET_LOCAL); emitShort(localNameConstant);
 	emitShort(unitConstant);
 
 	expr = expression();
 	if (expr.type != Type::Int) error(u8"Eine für Anweisung kann nur durch Zahlen iterieren!");
 
-	emitBytes(op::GREATER, (uint8_t)op::NOT);
+	//the first check decides if the loop counts up or down and stores it in a hidden local, so the byte code stays the same for every run
+	std::string directionName = localName + u8" abwärts";
+	addLocal(directionName, Type::Bool);
+	emitByte(op::FOR_CONDITION);
+	emitShort(makeConstant(directionName));
+	emitShort(unitConstant);
 	emitByte(op::FORDONE);
 
 	int exitJump = emitJump(op::JUMP_IF_FALSE);
@@ -1591,11 +2127,11 @@ void Compiler::forStatement()
 		consume(TokenType::SCHRITTGROESSE, u8"Nach 'mit' in einer für Anweisung wird 'schrittgröße' erwartet!");
 		expr = expression();
 		if (expr.type != Type::Int) error(u8"Eine für Anweisung kann nur durch Zahlen iterieren!");
-		emitBytes(op::GET_LOCAL, localNameConstant);
+		emitByte(op::GET_LOCAL); emitShort(localNameConstant);
 		emitShort(unitConstant);
 		emitByte(op::ADD);
 
-		emitBytes(op::SET_LOCAL, localNameConstant);
+		emitByte(op::SET_LOCAL); emitShort(localNameConstant);
 		emitShort(unitConstant);
 		emitByte(op::POP);
 
@@ -1604,10 +2140,10 @@ void Compiler::forStatement()
 	else
 	{
 		emitConstant(Value(1));
-		emitBytes(op::GET_LOCAL, localNameConstant);
+		emitByte(op::GET_LOCAL); emitShort(localNameConstant);
 		emitShort(unitConstant);
 		emitByte(op::ADD);
-		emitBytes(op::SET_LOCAL, localNameConstant);
+		emitByte(op::SET_LOCAL); emitShort(localNameConstant);
 		emitShort(unitConstant);
 		emitByte(op::POP);
 
@@ -1631,6 +2167,245 @@ void Compiler::forStatement()
 	unit.endUnit(currentScopeUnit);
 }
 
+void Compiler::forEachStatement(const std::string& keyName, Type keyType)
+{
+	uint16_t unitConstant = makeConstant(currentScopeUnit->identifier);
+	uint16_t keyConstant = makeConstant(keyName);
+	addLocal(keyName, keyType);
+
+	consume(TokenType::IN, u8"Es wurde ein 'in' erwartet!");
+	ValueType dictionary = expression();
+	if (dictionary.type != Type::Dictionary) error(u8"Eine für jeden Anweisung kann nur durch die Schlüssel eines Wörterbuchs iterieren!");
+
+	//the keys are copied into a hidden array first, so the body can change the Wörterbuch without disturbing the loop
+	std::string keysName = keyName + u8" Schlüssel";
+	std::string positionName = keyName + u8" Position";
+	addLocal(keysName, keyType == Type::String ? Type::StringArr : Type::IntArr);
+	addLocal(positionName, Type::Int);
+	uint16_t keysConstant = makeConstant(keysName);
+	uint16_t positionConstant = makeConstant(positionName);
+
+	emitBytes(op::DICTIONARY_KEYS, (uint8_t)keyType);
+	emitByte(op::SET_LOCAL); emitShort(keysConstant);
+	emitShort(unitConstant);
+	emitByte(op::POP);
+	emitConstant(Value(0));
+	emitByte(op::SET_LOCAL); emitShort(positionConstant);
+	emitShort(unitConstant);
+	emitByte(op::POP);
+
+	consume(TokenType::COMMA, u8"Es wurde ein ',' erwartet!");
+	consume(TokenType::MACHE, u8"Es wurde ein 'mache' erwartet!");
+	consume(TokenType::COLON, u8"Nach einer für Anweisung sollte ein neuer Bereich beginnen!");
+
+	int loopStart = static_cast<int>(currentChunk()->bytes.size());
+	emitByte(op::NEXT_KEY);
+	emitShort(keysConstant); emitShort(positionConstant); emitShort(keyConstant);
+	emitShort(unitConstant);
+	int exitJump = emitJump(op::JUMP_IF_FALSE);
+	emitByte(op::POP);
+
+	while (currIt->type != TokenType::END && currIt->depth >= currentScopeUnit->scopeDepth)
+		declaration();
+
+	emitLoop(loopStart);
+
+	patchJump(exitJump);
+	emitByte(op::POP);
+}
+
+void Compiler::removeStatement()
+{
+	checkKeyType(expression());
+	consume(TokenType::AUS, u8"Nach dem Schlüssel wurde 'aus' erwartet!");
+	consume(TokenType::IDENTIFIER, u8"Es wurde der Name eines Wörterbuchs erwartet!");
+	std::string dictName(preIt->literal);
+
+	auto [local, type] = getLocal(dictName);
+	if (local == -1)
+	{
+		if (globals.count(dictName) == 0)
+		{
+			error(u8"Die globale Variable '" + dictName + u8"' wurde noch nicht definiert!");
+			return;
+		}
+		type = globals.at(dictName);
+	}
+	if (type.type != Type::Dictionary)
+		error(u8"Es kann nur aus einem Wörterbuch entfernt werden!");
+	checkParallelWrite(local, dictName);
+	consume(TokenType::DOT, u8"Es fehlt ein Punkt nach einer 'entferne' Anweisung!");
+
+	emitByte(local == -1 ? op::REMOVE_KEY : op::REMOVE_KEY_LOCAL); emitShort(makeConstant(dictName));
+	if (local != -1)
+		emitShort(makeConstant(local));
+}
+
+bool Compiler::isParallelFor()
+{
+	//the expressions of the header can contain ',' only inside of the parentheses of a call
+	int parens = 0;
+	for (auto it = currIt; it->type != TokenType::END && it->type != TokenType::COLON; it++)
+	{
+		if (it->type == TokenType::LEFT_PAREN) parens++;
+		else if (it->type == TokenType::RIGHT_PAREN) parens--;
+		else if (parens == 0 && it->type == TokenType::COMMA)
+			return (it + 1)->type == TokenType::PARALLEL;
+	}
+	return false;
+}
+
+void Compiler::parallelForStatement(const std::string& counter, uint16_t counterConstant, uint16_t unitConstant)
+{
+	if (parallelLoop != nullptr)
+		error(u8"Parallele für Anweisungen können nicht verschachtelt werden!");
+
+	//from, to and step are left on the stack for PARALLEL_FOR
+	ValueType expr = expression();
+	if (expr.type != Type::Int) error(u8"Eine für Anweisung kann nur durch Zahlen iterieren!");
+	consume(TokenType::BIS, u8"Es wurde ein 'bis' erwartet!");
+	expr = expression();
+	if (expr.type != Type::Int) error(u8"Eine für Anweisung kann nur durch Zahlen iterieren!");
+	if (match(TokenType::MIT))
+	{
+		consume(TokenType::SCHRITTGROESSE, u8"Nach 'mit' in einer für Anweisung wird 'schrittgröße' erwartet!");
+		expr = expression();
+		if (expr.type != Type::Int) error(u8"Eine für Anweisung kann nur durch Zahlen iterieren!");
+	}
+	else
+		emitConstant(Value(1));
+
+	consume(TokenType::COMMA, u8"Es wurde ein ',' erwartet!");
+	consume(TokenType::PARALLEL, u8"Es wurde ein 'parallel' erwartet!");
+	consume(TokenType::MACHE, u8"Es wurde ein 'mache' erwartet!");
+	consume(TokenType::COLON, u8"Nach einer für Anweisung sollte ein neuer Bereich beginnen!");
+
+	emitByte(op::PARALLEL_FOR);
+	emitShort(counterConstant);
+	emitShort(unitConstant);
+	int bodyJump = static_cast<int>(currentChunk()->bytes.size());
+	emitShort(0xffff); //PARALLEL_FOR jumps over the body after running it, patched like a jump
+
+	ParallelLoop loop{ currentScopeUnit->identifier, counter };
+	ParallelLoop* enclosingLoop = parallelLoop;
+	parallelLoop = &loop;
+
+	while (currIt->type != TokenType::END && currIt->depth >= currentScopeUnit->scopeDepth)
+		declaration();
+
+	parallelLoop = enclosingLoop;
+	emitByte(op::PARALLEL_END);
+	patchJump(bodyJump);
+}
+
+bool Compiler::isParallelPrivate(int local, const std::string& varName)
+{
+	return local != -1 && local >= parallelLoop->unit && !(local == parallelLoop->unit && varName == parallelLoop->counter);
+}
+
+void Compiler::checkParallelWrite(int local, const std::string& varName)
+{
+	if (parallelLoop == nullptr || isParallelPrivate(local, varName)) return;
+	if (local == parallelLoop->unit && varName == parallelLoop->counter)
+		error(u8"Die Zähl Variable einer parallelen für Anweisung kann nicht verändert werden!");
+	else
+		error(u8"In einer parallelen für Anweisung können nur Variablen verändert werden, die in ihr definiert wurden!");
+}
+
+bool Compiler::isParallelCounter(size_t indexStart)
+{
+	if (parallelLoop == nullptr) return false;
+
+	//the index has to be exactly 'GET_LOCAL <counter> <unit>', then no two iterations write the same element
+	const std::vector<uint8_t>& bytes = currentChunk()->bytes;
+	auto constantAt = [&](size_t i) -> Value& { return currentChunk()->constants[(bytes[i] << 8) | bytes[i + 1]]; };
+	return bytes.size() == indexStart + 5
+		&& bytes[indexStart] == (uint8_t)op::GET_LOCAL
+		&& constantAt(indexStart + 1).type() == Type::String && *constantAt(indexStart + 1).String() == parallelLoop->counter
+		&& constantAt(indexStart + 3).type() == Type::Int && constantAt(indexStart + 3).Int() == parallelLoop->unit;
+}
+
+void Compiler::checkParallelElementWrite(int local, const std::string& arrName, bool indexIsCounter, Type elementType)
+{
+	if (parallelLoop == nullptr || isParallelPrivate(local, arrName)) return;
+	if (elementType == Type::Bool) //the elements of a std::vector<bool> share their bytes
+		error(u8"In einer parallelen für Anweisung können Booleans von außerhalb nicht verändert werden!");
+	else if (!indexIsCounter)
+		error(u8"In einer parallelen für Anweisung können Arrays und Matrizen von außerhalb nur an der Stelle der Zähl Variable verändert werden!");
+}
+
+bool Compiler::sharesData(ValueType type)
+{
+	return isArr(type) || type.type == Type::Struct || type.type == Type::Matrix || type.type == Type::Dictionary;
+}
+
+Compiler::ScopeUnit* Compiler::unitOf(int local)
+{
+	for (ScopeUnit* unit = currentScopeUnit; unit != nullptr; unit = unit->enclosingUnit)
+	{
+		if (unit->identifier == local)
+			return unit;
+	}
+	return nullptr;
+}
+
+void Compiler::markShared(int local, const std::string& varName)
+{
+	if (local == -1)
+	{
+		if (!varName.empty())
+			sharedGlobals.insert(varName);
+	}
+	else if (ScopeUnit* unit = unitOf(local))
+		unit->shared.insert(varName);
+}
+
+bool Compiler::isShared(int local, const std::string& varName)
+{
+	if (local == -1)
+		return varName.empty() || sharedGlobals.count(varName) != 0;
+	ScopeUnit* unit = unitOf(local);
+	return unit == nullptr || unit->shared.count(varName) != 0;
+}
+
+bool Compiler::readsOutside(size_t readsStart)
+{
+	if (parallelLoop == nullptr) return false;
+	for (auto it = referenceReads.begin() + readsStart; it != referenceReads.end(); it++)
+	{
+		if (!isParallelPrivate(it->first, it->second))
+			return true;
+	}
+	return false;
+}
+
+void Compiler::assignReads(size_t readsStart, int local, const std::string& varName)
+{
+	if (referenceReads.size() == readsStart) return;
+	//another iteration could change the array through the new variable while this one reads it
+	if (readsOutside(readsStart))
+		error(u8"In einer parallelen für Anweisung können Arrays, Strukturen, Matrizen und Wörterbücher von außerhalb keiner Variable zugewiesen werden!");
+	markShared(local, varName);
+	for (auto it = referenceReads.begin() + readsStart; it != referenceReads.end(); it++)
+		markShared(it->first, it->second);
+	referenceReads.resize(readsStart);
+}
+
+void Compiler::passReads(size_t readsStart)
+{
+	if (readsOutside(readsStart))
+		error(u8"In einer parallelen für Anweisung können Arrays, Strukturen, Matrizen und Wörterbücher von außerhalb keiner Funktion übergeben werden!");
+	for (auto it = referenceReads.begin() + readsStart; it != referenceReads.end(); it++)
+		markShared(it->first, it->second);
+}
+
+void Compiler::patchGlobalAppends()
+{
+	//a function compiled later may still share a global or start a task, then the APPENDs that were patched before copy again
+	for (GlobalAppend& append : globalAppends)
+		append.chunk->bytes[append.flag] = startsTasks || sharedGlobals.count(append.arrName) != 0;
+}
+
 #ifndef NDEBUG
 void Compiler::printStatement()
 {
@@ -1668,6 +2443,16 @@ void Compiler::ScopeUnit::endUnit(ScopeUnit*& currentScopeUnit)
 	}
 	enclosingFunction->locals.insert(std::make_pair(identifier, std::move(temp)));
 
+	//all uses of the locals were compiled now. The arguments share their arrays with the caller
+	const auto& args = enclosingFunction->args;
+	for (auto& append : appends)
+	{
+		bool argument = identifier == enclosingFunction->argUnit &&
+			std::any_of(args.begin(), args.end(), [&](auto& arg) { return arg.first == append.second; });
+		if (shared.count(append.second) == 0 && !argument)
+			enclosingFunction->chunk->bytes[append.first] = 0;
+	}
+
 	currentScopeUnit = enclosingUnit;
 }
 
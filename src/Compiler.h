@@ -2,6 +2,18 @@
 
 #include "Scanner.h"
 #include "Function.h"
+#include <array>
+#include <unordered_set>
+
+//true if rules[i] is the rule for TokenType i for every i (used to validate Compiler::parseRules at compile time)
+template<typename Rules>
+constexpr bool isIndexedByTokenType(const Rules& rules)
+{
+	for (size_t i = 0; i < rules.size(); i++)
+		if ((size_t)rules[i].type != i)
+			return false;
+	return rules.size() == (size_t)TokenType::COUNT;
+}
 
 class Compiler
 {
@@ -11,18 +23,21 @@ public:
 	Compiler(const std::string& filePath,
 		std::unordered_map<std::string, Value>* globals,
 		std::unordered_map<std::string, Function>* functions,
-		std::unordered_map<std::string, Value::Struct>* structs);
+		std::unordered_map<std::string, Value::Struct>* structs,
+		bool eager);
 
 	bool compile(); //returns true on success, fills globals with declarations and functions with definitions
+	bool compileFunction(const std::string& name); //compiles the body of a function that was skipped by compile(), returns true on success
 private:
 	void finishCompilation();
 	static Value GetDefaultValue(ValueType type);
 
 	void makeNatives();
-	void addNative(std::string name, Type returnType, std::vector<Natives::CombineableValueType> args, Function::NativePtr native);
+	void addNative(std::string name, Type returnType, std::vector<Natives::CombineableValueType> args, Function::NativePtr native,
+		Function::NativeReturn nativeReturn = Function::NativeReturn::Declared, Function::ArgUse argUse = Function::ArgUse::Read);
 private:
 	Function* currentFunction() { return currentScopeUnit->enclosingFunction; }; //the function that is currently being compiled (most often the nameless main function)
-	Chunk* currentChunk() { return &currentFunction()->chunk; }; //the chunk that is currently filled
+	Chunk* currentChunk() { return currentFunction()->chunk.get(); }; //the chunk that is currently filled
 
 	//common emits
 	void emitByte(uint8_t byte) { currentChunk()->write(byte); };
@@ -73,6 +88,8 @@ private:
 		int identifier; //the unique identifier of this unit, evaluated using count in the constructor
 
 		std::unordered_map<std::string, ValueType> locals; //local variables in this scopeUnit
+		std::unordered_set<std::string> shared; //locals that may share their array, struct, Matrix or Woerterbuch with another variable
+		std::vector<std::pair<size_t, std::string>> appends; //offsets of the flags of the APPEND_LOCALs to the locals of this unit, see endUnit
 	};
 private:
 	void declaration(); //starting point of the compiler
@@ -95,6 +112,7 @@ private:
 	void varDeclaration();
 	ValueType tokenToValueType(TokenType type); //helper for funDeclaration
 	void funDeclaration();
+	void functionBody(Function& function); //helper for funDeclaration and compileFunction
 	void returnStatement();
 	void structDeclaration();
 
@@ -103,6 +121,26 @@ private:
 	void ifStatement();
 	void whileStatement();
 	void forStatement();
+	bool isParallelFor(); //look ahead if the fuer Anweisung that is compiled ends with ', parallel mache:'
+	void parallelForStatement(const std::string& counter, uint16_t counterConstant, uint16_t unitConstant);
+	void forEachStatement(const std::string& keyName, Type keyType); //'fuer jeden Text/jede Zahl <keyName> in <Woerterbuch>', runs the body for every key
+	void removeStatement(); //'entferne <Schluessel> aus <Woerterbuch>.'
+
+	//a parallel fuer body may only change its own variables, and arrays from outside only at the index of the loop variable, so the iterations can run at the same time
+	bool isParallelPrivate(int local, const std::string& varName); //true if the variable was defined in the parallel fuer body that is compiled
+	void checkParallelWrite(int local, const std::string& varName); //report an error if varName may not be assigned in the current parallel fuer body
+	bool isParallelCounter(size_t indexStart); //true if the code emitted since indexStart only gets the loop variable of the current parallel fuer body
+	void checkParallelElementWrite(int local, const std::string& arrName, bool indexIsCounter, Type elementType); //same for an element of an array
+
+	//arrays, structs, Matrizen and Woerterbuecher are not copied when they are assigned, so the compiler remembers which variables may share them
+	[[nodiscard]] static bool sharesData(ValueType type); //true for the types whose copies share their data
+	[[nodiscard]] ScopeUnit* unitOf(int local); //the scopeUnit with the identifier local, nullptr if it already ended
+	void markShared(int local, const std::string& varName); //varName may share its data with another variable from now on
+	[[nodiscard]] bool isShared(int local, const std::string& varName);
+	[[nodiscard]] bool readsOutside(size_t readsStart); //true if the value compiled since readsStart may share data with a variable from outside of the current parallel fuer body
+	void assignReads(size_t readsStart, int local, const std::string& varName); //the value compiled since readsStart is stored in varName
+	void passReads(size_t readsStart); //the value compiled since readsStart is given to a function that may keep it
+	void patchGlobalAppends(); //let the APPENDs to globals that no other variable shares append in place, again after every compiled function
 
 #ifndef NDEBUG
 	void printStatement();
@@ -147,122 +185,152 @@ private:
 	[[nodiscard]] ValueType or_(bool canAssign);
 	[[nodiscard]] std::pair<int, ValueType> getLocal(std::string name); //return the ScopeUnit identifier the local is in. Returns -1 if not found
 	[[nodiscard]] ValueType memberAccess(bool canAssign, std::string varName); //helper vor variable to handle struct member access
+	[[nodiscard]] bool isSlice(const std::string& varName); //true if the 'von' after varName starts a slice and not a member access
 	[[nodiscard]] ValueType variable(bool canAssign);
 	void index(bool canAssign, std::string arrName, ValueType type, int local); //helper for variable to handle array indexing
+	void dictionaryElement(std::string dictName, int local); //helper for variable to get or set the value of a key in a Woerterbuch
+	void appendToArray(const std::string& arrName, ValueType type, int local); //helper for variable to compile 'arr sind arr plus x [plus y...]'
+	void appendToString(const std::string& varName, int local); //same for 'text ist text plus x [plus y...]'
+	void slice(const std::string& arrName, int local); //helper for variable to compile 'arr von a bis b'
+	[[nodiscard]] ValueType contains(bool canAssign); //'<Woerterbuch> enthaelt <Schluessel>'
+	void checkKeyType(ValueType key); //report an error if key can not be the key of a Woerterbuch
 	[[nodiscard]] ValueType call(bool canAssign);
+	[[nodiscard]] ValueType emitCall(OpCode callOp); //helper for call and startTask to check the arguments and emit callOp
+	[[nodiscard]] ValueType startTask(bool canAssign); //'starte f(...)', evaluates to the number of the task
+	[[nodiscard]] ValueType awaitTask(bool canAssign); //'erwarte <Aufgabe> [als <Typ>]', evaluates to the result of the task
+	[[nodiscard]] ValueType receive(bool canAssign); //'empfange <Kanal> als <Typ>', evaluates to the next value of the channel
+	[[nodiscard]] ValueType resultType(); //the <Typ> after 'als' in erwarte and empfange
 private:
 	using MemFunctPtr = ValueType(Compiler::*)(bool); //pointer to a member function of Compiler that takes a bool and returns a ValueType
 	struct ParseRule
 	{
+		TokenType type; //the token the rule belongs to, only used to validate the table
 		MemFunctPtr prefix; //function for the prefix use of the operator
 		MemFunctPtr infix; //function for the infix use of the operator
 		Precedence precedence; //the precedende of the operator
 	};
-	static inline const std::unordered_map<TokenType, ParseRule> parseRules = {
-		{ TokenType::LEFT_PAREN,	ParseRule{&Compiler::grouping, &Compiler::call,	Precedence::Call}},
-		{ TokenType::RIGHT_PAREN,	ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::LEFT_CURLY,	ParseRule{nullptr,			&Compiler::structLiteral, Precedence::Call}},
-		{ TokenType::RIGHT_CURLY,	ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::COLON,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::COMMA,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::DOT,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::MINUS,			ParseRule{nullptr,			&Compiler::binary,  Precedence::Term}},
-		{ TokenType::NEGATEMINUS,   ParseRule{&Compiler::unary,	nullptr,			Precedence::Term}},
-		{ TokenType::PLUS,			ParseRule{nullptr,			&Compiler::binary,  Precedence::Term}},
-		{ TokenType::DURCH,			ParseRule{nullptr,			&Compiler::binary,  Precedence::Factor}},
-		{ TokenType::MAL,			ParseRule{nullptr,			&Compiler::binary,  Precedence::Factor}},
-		{ TokenType::NICHT,			ParseRule{&Compiler::unary,	nullptr,			Precedence::Unary}},
-		{ TokenType::MODULO,		ParseRule{nullptr,			&Compiler::binary,	Precedence::Term}},
-		{ TokenType::HOCH,			ParseRule{nullptr,			&Compiler::binary,	Precedence::Exponent}},
-		{ TokenType::WURZEL,		ParseRule{nullptr,			&Compiler::binary,  Precedence::Exponent}},
-		{ TokenType::UM,			ParseRule{nullptr,			&Compiler::binary,	Precedence::Bitshift}},
-		{ TokenType::LOGISCH,		ParseRule{&Compiler::bitwise,nullptr,			Precedence::Bitwise}},
-		{ TokenType::LOGISCHNICHT,  ParseRule{&Compiler::unary, nullptr,			Precedence::Unary}},
-		{ TokenType::LN,			ParseRule{&Compiler::unary, nullptr,			Precedence::Unary}},
-		{ TokenType::BETRAG,		ParseRule{&Compiler::unary, nullptr,			Precedence::Unary}},
-		{ TokenType::UNGLEICH,		ParseRule{nullptr,			&Compiler::binary,	Precedence::Equality}},
-		{ TokenType::GLEICH,		ParseRule{nullptr,			&Compiler::binary,	Precedence::Equality}},
-		{ TokenType::GROESSER,		ParseRule{nullptr,			&Compiler::binary,	Precedence::Comparison}},
-		{ TokenType::KLEINER,		ParseRule{nullptr,			&Compiler::binary,	Precedence::Comparison}},
-		{ TokenType::GROESSERODER,	ParseRule{nullptr,			&Compiler::binary,	Precedence::Comparison}},
-		{ TokenType::KLEINERODER,	ParseRule{nullptr,			&Compiler::binary,	Precedence::Comparison}},
-		{ TokenType::IDENTIFIER,	ParseRule{&Compiler::variable,nullptr,			Precedence::None}},
-		{ TokenType::STRING,		ParseRule{&Compiler::string,nullptr,			Precedence::None}},
-		{ TokenType::INUMBER,		ParseRule{&Compiler::inumber,nullptr,			Precedence::None}},
-		{ TokenType::DNUMBER,		ParseRule{&Compiler::dnumber,nullptr,			Precedence::None}},
-		{ TokenType::CHARACTER,		ParseRule{&Compiler::character,nullptr,			Precedence::None}},
-		{ TokenType::UND,			ParseRule{nullptr,			&Compiler::and_,	Precedence::And}},
-		{ TokenType::SONST,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::FALSCH,		ParseRule{&Compiler::Literal,nullptr,			Precedence::None}},
-		{ TokenType::PI,			ParseRule{&Compiler::Literal,nullptr,			Precedence::None}},
-		{ TokenType::TAU,			ParseRule{&Compiler::Literal,nullptr,			Precedence::None}},
-		{ TokenType::E,				ParseRule{&Compiler::Literal,nullptr,			Precedence::None}},
-		{ TokenType::PHI,			ParseRule{&Compiler::Literal,nullptr,			Precedence::None}},
-		{ TokenType::FUER,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::FUNKTION,		ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::WENN,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::ODER,			ParseRule{nullptr,			&Compiler::or_,		Precedence::Or}},
-		{ TokenType::IST,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::GIB,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::ZURUECK,		ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::WAHR,			ParseRule{&Compiler::Literal,nullptr,			Precedence::None}},
-		{ TokenType::ZAHL,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::KOMMAZAHL,		ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::BOOLEAN,		ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::BUCHSTABE,		ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::TEXT,	ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::ZAHLEN,		ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::BOOLEANS,		ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::KOMMAZAHLEN,	ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::TEXTE,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::BUCHSTABEN,	ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::AN,			ParseRule{nullptr,			nullptr,			Precedence::Call}},
-		{ TokenType::STELLE,		ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::STUECK,		ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::LEFT_SQAREBRACKET,ParseRule{&Compiler::arrLiteral,	nullptr,	Precedence::None}},
-		{ TokenType::RIGHT_SQAREBRACKET,ParseRule{nullptr,		nullptr,			Precedence::None}},
-		{ TokenType::SEMICOLON,		ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::SOLANGE,		ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::ALS,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::BIT,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::NACH,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::RECHTS,		ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::LINKS,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::VERSCHOBEN,	ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::KONTRA,		ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::ABER,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::DANN,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::JEDE,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::VON,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::BIS,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::MIT,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::SCHRITTGROESSE,ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::MACHE,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::VOM,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::TYP,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::SIND,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::DER,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::DIE,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::SIN,			ParseRule{&Compiler::unary, nullptr,			Precedence::Unary}},
-		{ TokenType::COS,			ParseRule{&Compiler::unary, nullptr,			Precedence::Unary}},
-		{ TokenType::TAN,			ParseRule{&Compiler::unary, nullptr,			Precedence::Unary}},
-		{ TokenType::ASIN,			ParseRule{&Compiler::unary, nullptr,			Precedence::Unary}},
-		{ TokenType::ACOS,			ParseRule{&Compiler::unary, nullptr,			Precedence::Unary}},
-		{ TokenType::ATAN,			ParseRule{&Compiler::unary, nullptr,			Precedence::Unary}},
-		{ TokenType::SINH,			ParseRule{&Compiler::unary, nullptr,			Precedence::Unary}},
-		{ TokenType::COSH,			ParseRule{&Compiler::unary, nullptr,			Precedence::Unary}},
-		{ TokenType::TANH,			ParseRule{&Compiler::unary, nullptr,			Precedence::Unary}},
-		{ TokenType::STRUKTUR,		ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::STRUKTUREN,	ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::BESCHREIBT,	ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::TANH,			ParseRule{&Compiler::unary, nullptr,			Precedence::Unary}},
-		{ TokenType::TANH,			ParseRule{&Compiler::unary, nullptr,			Precedence::Unary}},
-		{ TokenType::ERROR,			ParseRule{nullptr,			nullptr,			Precedence::None}},
-		{ TokenType::END,			ParseRule{nullptr,			nullptr,			Precedence::None}}
-#ifdef _MDEBUG_
-		,{TokenType::PRINT,			ParseRule{nullptr,			nullptr,			Precedence::None}}
+	//indexed by TokenType, so the rules have to be in the same order as the enum
+	static constexpr std::array<ParseRule, (size_t)TokenType::COUNT> parseRules = { {
+		ParseRule{ TokenType::COLON,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::DOT,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::COMMA,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::LEFT_PAREN,	&Compiler::grouping, &Compiler::call,	Precedence::Call },
+		ParseRule{ TokenType::RIGHT_PAREN,	nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::LEFT_CURLY,	nullptr,			&Compiler::structLiteral, Precedence::Call },
+		ParseRule{ TokenType::RIGHT_CURLY,	nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::IDENTIFIER,	&Compiler::variable,nullptr,			Precedence::None },
+		ParseRule{ TokenType::STRING,		&Compiler::string,nullptr,			Precedence::None },
+		ParseRule{ TokenType::CHARACTER,		&Compiler::character,nullptr,			Precedence::None },
+		ParseRule{ TokenType::INUMBER,		&Compiler::inumber,nullptr,			Precedence::None },
+		ParseRule{ TokenType::DNUMBER,		&Compiler::dnumber,nullptr,			Precedence::None },
+		ParseRule{ TokenType::NEGATEMINUS,   &Compiler::unary,	nullptr,			Precedence::Term },
+		ParseRule{ TokenType::PLUS,			nullptr,			&Compiler::binary,  Precedence::Term },
+		ParseRule{ TokenType::MINUS,			nullptr,			&Compiler::binary,  Precedence::Term },
+		ParseRule{ TokenType::MAL,			nullptr,			&Compiler::binary,  Precedence::Factor },
+		ParseRule{ TokenType::DURCH,			nullptr,			&Compiler::binary,  Precedence::Factor },
+		ParseRule{ TokenType::MODULO,		nullptr,			&Compiler::binary,	Precedence::Term },
+		ParseRule{ TokenType::HOCH,			nullptr,			&Compiler::binary,	Precedence::Exponent },
+		ParseRule{ TokenType::WURZEL,		nullptr,			&Compiler::binary,  Precedence::Exponent },
+		ParseRule{ TokenType::LN,			&Compiler::unary, nullptr,			Precedence::Unary },
+		ParseRule{ TokenType::BETRAG,		&Compiler::unary, nullptr,			Precedence::Unary },
+		ParseRule{ TokenType::PI,			&Compiler::Literal,nullptr,			Precedence::None },
+		ParseRule{ TokenType::E,				&Compiler::Literal,nullptr,			Precedence::None },
+		ParseRule{ TokenType::TAU,			&Compiler::Literal,nullptr,			Precedence::None },
+		ParseRule{ TokenType::PHI,			&Compiler::Literal,nullptr,			Precedence::None },
+		ParseRule{ TokenType::SIN,			&Compiler::unary, nullptr,			Precedence::Unary },
+		ParseRule{ TokenType::COS,			&Compiler::unary, nullptr,			Precedence::Unary },
+		ParseRule{ TokenType::TAN,			&Compiler::unary, nullptr,			Precedence::Unary },
+		ParseRule{ TokenType::ASIN,			&Compiler::unary, nullptr,			Precedence::Unary },
+		ParseRule{ TokenType::ACOS,			&Compiler::unary, nullptr,			Precedence::Unary },
+		ParseRule{ TokenType::ATAN,			&Compiler::unary, nullptr,			Precedence::Unary },
+		ParseRule{ TokenType::SINH,			&Compiler::unary, nullptr,			Precedence::Unary },
+		ParseRule{ TokenType::COSH,			&Compiler::unary, nullptr,			Precedence::Unary },
+		ParseRule{ TokenType::TANH,			&Compiler::unary, nullptr,			Precedence::Unary },
+		ParseRule{ TokenType::UND,			nullptr,			&Compiler::and_,	Precedence::And },
+		ParseRule{ TokenType::ODER,			nullptr,			&Compiler::or_,		Precedence::Or },
+		ParseRule{ TokenType::NICHT,			&Compiler::unary,	nullptr,			Precedence::Unary },
+		ParseRule{ TokenType::KLEINER,		nullptr,			&Compiler::binary,	Precedence::Comparison },
+		ParseRule{ TokenType::GROESSER,		nullptr,			&Compiler::binary,	Precedence::Comparison },
+		ParseRule{ TokenType::ALS,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::KLEINERODER,	nullptr,			&Compiler::binary,	Precedence::Comparison },
+		ParseRule{ TokenType::GROESSERODER,	nullptr,			&Compiler::binary,	Precedence::Comparison },
+		ParseRule{ TokenType::UNGLEICH,		nullptr,			&Compiler::binary,	Precedence::Equality },
+		ParseRule{ TokenType::GLEICH,		nullptr,			&Compiler::binary,	Precedence::Equality },
+		ParseRule{ TokenType::ENTHAELT,		nullptr,			&Compiler::contains,Precedence::Comparison },
+		ParseRule{ TokenType::UM,			nullptr,			&Compiler::binary,	Precedence::Bitshift },
+		ParseRule{ TokenType::BIT,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::NACH,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::RECHTS,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::LINKS,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::VERSCHOBEN,	nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::LOGISCH,		&Compiler::bitwise,nullptr,			Precedence::Bitwise },
+		ParseRule{ TokenType::KONTRA,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::LOGISCHNICHT,  &Compiler::unary, nullptr,			Precedence::Unary },
+		ParseRule{ TokenType::WENN,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::ABER,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::DANN,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::SONST,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::FUER,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::JEDE,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::VON,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::BIS,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::MIT,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::SCHRITTGROESSE,nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::PARALLEL,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::IN,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::SOLANGE,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::MACHE,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::FUNKTION,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::MACHT,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::VOM,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::TYP,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::IST,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::SIND,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::DER,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::DIE,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::DAS,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::ZAHL,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::KOMMAZAHL,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::BOOLEAN,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::BUCHSTABE,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::TEXT,	nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::ZAHLEN,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::KOMMAZAHLEN,	nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::BOOLEANS,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::BUCHSTABEN,	nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::TEXTE,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::BYTES,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::MATRIX,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::WOERTERBUCH,	nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::STRUKTUR,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::STRUKTUREN,	nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::AN,			nullptr,			nullptr,			Precedence::Call },
+		ParseRule{ TokenType::STELLE,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::STUECK,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::LEFT_SQAREBRACKET,&Compiler::arrLiteral,	nullptr,	Precedence::None },
+		ParseRule{ TokenType::RIGHT_SQAREBRACKET,nullptr,		nullptr,			Precedence::None },
+		ParseRule{ TokenType::SEMICOLON,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::BESCHREIBT,	nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::ENTFERNE,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::AUS,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::WAHR,			&Compiler::Literal,nullptr,			Precedence::None },
+		ParseRule{ TokenType::FALSCH,		&Compiler::Literal,nullptr,			Precedence::None },
+		ParseRule{ TokenType::GIB,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::ZURUECK,		nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::STARTE,		&Compiler::startTask,nullptr,			Precedence::None },
+		ParseRule{ TokenType::ERWARTE,		&Compiler::awaitTask,nullptr,			Precedence::None },
+		ParseRule{ TokenType::EMPFANGE,		&Compiler::receive,	nullptr,			Precedence::None },
+#ifndef NDEBUG
+		ParseRule{ TokenType::PRINT,			nullptr,			nullptr,			Precedence::None },
 #endif
-	};
+		ParseRule{ TokenType::BINDE,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::EIN,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::DIRECTIVE,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::ERROR,			nullptr,			nullptr,			Precedence::None },
+		ParseRule{ TokenType::END,			nullptr,			nullptr,			Precedence::None }
+	} };
+	static_assert(isIndexedByTokenType(parseRules), "parseRules must contain exactly one rule per TokenType, in the order of the enum");
+	static constexpr const ParseRule& getRule(TokenType type) { return parseRules[(size_t)type]; };
 private:
 	const std::string filePath;
 
@@ -273,9 +341,13 @@ private:
 	std::unordered_map<std::string, Function>* functions;
 	std::unordered_map<std::string, Value::Struct>* runtimeStructs;
 
+	const bool eager; //compile all function bodies at the end of compile() instead of on their first call
+	std::unordered_map<std::string, std::vector<Token>::iterator> lazyBodies; //first token of every function body that was not compiled yet
+
 	bool hadError; //did an error occure?
 	bool panicMode; //are we currently handling an error?
 private:
+	SourceArena sources; //the source code the tokens view into
 	std::vector<Token> tokens; //output from the scanner
 	std::vector<Token>::iterator preIt; //previously scanned token
 	std::vector<Token>::iterator currIt; //current token
@@ -284,6 +356,25 @@ private:
 
 	ValueType lastEmittedType;
 
+	struct ParallelLoop
+	{
+		int unit; //identifier of the scopeUnit of the loop, it and all later units belong to the body
+		std::string counter; //name of the loop variable
+	};
+	ParallelLoop* parallelLoop; //the parallel fuer body that is currently compiled, nullptr if there is none
+
 	std::string calledFuncName; //the name of the function that was lastly called
+
+	//the variables whose data the value of the expression that is compiled may share, as pairs of unit and name (-1 for globals, an empty name for an unknown global)
+	std::vector<std::pair<int, std::string>> referenceReads;
+	std::unordered_set<std::string> sharedGlobals; //globals that may share their data with another variable
+	struct GlobalAppend
+	{
+		std::shared_ptr<Chunk> chunk; //the chunk of the function the APPEND is in
+		size_t flag; //offset of the flag of the APPEND
+		std::string arrName;
+	};
+	std::vector<GlobalAppend> globalAppends;
+	bool startsTasks; //a task may read any global while the program appends to it
 };
 
@@ -0,0 +1,119 @@
+#include "Dictionary.h"
+#include "Natives.h"
+#include <functional>
+
+static constexpr size_t InitialCapacity = 16;
+
+Dictionary::Dictionary()
+	:
+	slots(InitialCapacity),
+	count(0),
+	keyType(Type::None)
+{}
+
+size_t Dictionary::hashOf(Value& key)
+{
+	size_t hash;
+	if (key.type() == Type::String)
+		hash = std::hash<std::string_view>()(*key.String());
+	else
+	{
+		//consecutive Zahlen would fill one run of slots, so their bits are mixed first (the splitmix64 finalizer)
+		uint64_t x = (uint64_t)(uint32_t)key.Int();
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+		hash = (size_t)(x ^ (x >> 31));
+	}
+	return hash == 0 ? 1 : hash;
+}
+
+bool Dictionary::sameKey(Value& a, Value& b)
+{
+	if (a.type() != b.type()) return false;
+	if (a.type() == Type::String) return *a.String() == *b.String();
+	return a.Int() == b.Int();
+}
+
+size_t Dictionary::findSlot(Value& key, size_t hash)
+{
+	size_t mask = slots.size() - 1;
+	size_t i = hash & mask;
+	//the load factor stays below 1, so there is always an empty slot to stop at
+	while (slots[i].hash != 0 && !(slots[i].hash == hash && sameKey(slots[i].key, key)))
+		i = (i + 1) & mask;
+	return i;
+}
+
+Value* Dictionary::find(Value& key)
+{
+	Slot& slot = slots[findSlot(key, hashOf(key))];
+	return slot.hash != 0 ? &slot.value : nullptr;
+}
+
+void Dictionary::set(Value& key, Value value)
+{
+	size_t hash = hashOf(key);
+	size_t i = findSlot(key, hash);
+	if (slots[i].hash != 0)
+	{
+		slots[i].value = std::move(value);
+		return;
+	}
+	if (count == 0)
+		keyType = key.type();
+	else if (key.type() != keyType)
+		throw runtime_error(u8"Ein Wrterbuch kann nicht Texte und Zahlen zugleich als Schlssel haben!");
+
+	//keep at most 3/4 of the slots used, above that the runs of linear probing get long
+	if ((count + 1) * 4 > slots.size() * 3)
+	{
+		grow();
+		i = findSlot(key, hash);
+	}
+	slots[i].hash = hash;
+	slots[i].key = key;
+	slots[i].value = std::move(value);
+	count++;
+}
+
+bool Dictionary::remove(Value& key)
+{
+	size_t mask = slots.size() - 1;
+	size_t i = findSlot(key, hashOf(key));
+	if (slots[i].hash == 0) return false;
+
+	//move every following entry of the run that may be placed at i into the hole, so no lookup stops early at it
+	for (size_t j = (i + 1) & mask; slots[j].hash != 0; j = (j + 1) & mask)
+	{
+		size_t home = slots[j].hash & mask;
+		bool homeBetween = i <= j ? (i < home && home <= j) : (i < home || home <= j); //home lies cyclically in (i, j], then the entry has to stay
+		if (!homeBetween)
+		{
+			slots[i] = std::move(slots[j]);
+			i = j;
+		}
+	}
+	slots[i] = Slot();
+	count--;
+	return true;
+}
+
+size_t Dictionary::size() const
+{
+	return count;
+}
+
+void Dictionary::grow()
+{
+	std::vector<Slot> old(slots.size() * 2);
+	old.swap(slots);
+	size_t mask = slots.size() - 1;
+	for (Slot& slot : old)
+	{
+		if (slot.hash == 0) continue;
+		size_t i = slot.hash & mask;
+		while (slots[i].hash != 0)
+			i = (i + 1) & mask;
+		slots[i] = std::move(slot);
+	}
+}
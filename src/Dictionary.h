@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Value.h"
+
+//a hash table from Texte or Zahlen to any Value (the Woerterbuch of the language). All keys have the same type, so they can be iterated as Texte or Zahlen.
+//Open addressing with linear probing: a key that collides goes into the next free slot, so a lookup only walks one contiguous array.
+//remove shifts the following entries back instead of leaving tombstones, so lookups do not get slower after many removals.
+//Like arrays a Dictionary is not locked, the globals lock protects it when tasks share it
+class Dictionary
+{
+public:
+	Dictionary();
+
+	Value* find(Value& key); //the value stored for key, nullptr if there is none
+	void set(Value& key, Value value); //insert key or overwrite its value. Throws if key has another type than the keys already in it
+	bool remove(Value& key); //false if key was not in the dictionary
+	size_t size() const;
+
+	//call f(key, value) for every entry, in the order of the table
+	template<typename F>
+	void forEach(F f)
+	{
+		for (Slot& slot : slots)
+		{
+			if (slot.hash != 0)
+				f(slot.key, slot.value);
+		}
+	}
+private:
+	struct Slot
+	{
+		size_t hash = 0; //0 marks an empty slot, hashOf never returns it
+		Value key;
+		Value value;
+	};
+
+	static size_t hashOf(Value& key);
+	static bool sameKey(Value& a, Value& b);
+
+	size_t findSlot(Value& key, size_t hash); //the slot of key or the empty slot where it would go
+	void grow(); //double the capacity and insert every entry again
+
+	std::vector<Slot> slots; //the size is always a power of 2
+	size_t count; //the number of used slots
+	Type keyType; //the type of every key, only meaningful while count > 0
+};
@@ -1,4 +1,5 @@
 #include "Function.h"
+#include "Compiler.h"
 #include <iostream>
 #include <ctime>
 #include <algorithm>
@@ -13,25 +14,41 @@ Function::Function()
 	functions(nullptr),
 	globals(nullptr),
 	structs(nullptr),
+	runtime(nullptr),
 	argUnit(0),
 	returned(false),
-	native(nullptr)
+	chunk(std::make_shared<Chunk>()),
+	native(nullptr),
+	nativeReturn(NativeReturn::Declared),
+	argUse(ArgUse::Read),
+	returnsShared(false),
+	lazyCompiler(nullptr),
+	parallelBody(false)
 {}
 
 Value Function::run(std::unordered_map<std::string, Value>* globals,
 	std::unordered_map<std::string, Function>* functions,
-	std::unordered_map<std::string, Value::Struct>* structs)
+	std::unordered_map<std::string, Value::Struct>* structs,
+	Natives::Runtime* runtime)
 {
 	using op = OpCode;
 
 	this->globals = globals;
 	this->functions = functions;
 	this->structs = structs;
+	this->runtime = runtime;
 
 	stack.resize(StackMax);
 
 	stackTop = stack.begin();
-	ip = chunk.bytes.begin();
+	ip = chunk->bytes.begin();
+
+	return execute();
+}
+
+Value Function::execute()
+{
+	using op = OpCode;
 
 	bool forPrep = false;
 
@@ -65,6 +82,7 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 					case Type::BoolArr: field = Value(std::vector<bool>(v1.Int(), false)); break;
 					case Type::CharArr: field = Value(std::vector<short>(v1.Int(), (short)0)); break;
 					case Type::StringArr: field = Value(std::vector<std::string>(v1.Int(), "")); break;
+					case Type::Bytes: field = Value(std::vector<uint8_t>(v1.Int(), (uint8_t)0)); break;
 					}
 					fieldName = *v2.String();
 				}
@@ -436,19 +454,7 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 			{
 				switch (b.type())
 				{
-				case Type::Int:
-				{
-					if (forPrep)
-					{
-						OpCode code = a.Int() <= b.Int() ? op::GREATER : op::LESS;
-						ip[-1] = (uint8_t)code;
-						if (code == op::GREATER) push(Value(a.Int() > b.Int()));
-						else push(Value(a.Int() < b.Int()));
-						break;
-					}
-					push(Value(a.Int() > b.Int()));
-					break;
-				}
+				case Type::Int: push(Value(a.Int() > b.Int())); break;
 				case Type::Double: push(Value((double)a.Int() > b.Double())); break;
 				}
 				break;
@@ -550,11 +556,12 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 		{
 			std::string varName = *readConstant().String();
 			Value val = pop();
+			auto lock = writeGlobals();
 			Type varType = globals->at(varName).type();
 			if (isArr(varType) && val.type() == Type::Int)
 			{
-				if (val.Int() <= 0)
-					throw runtime_error(u8"Ein Array muss mindestens 1 Element enthalten!");
+				if (val.Int() < 0) //empty arrays are fine, they can grow with 'plus'
+					throw runtime_error(u8"Ein Array kann nicht weniger als 0 Elemente enthalten!");
 				switch (varType)
 				{
 				case Type::IntArr: val = Value(std::vector<int>(val.Int(), 0)); break;
@@ -562,6 +569,7 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 				case Type::BoolArr: val = Value(std::vector<bool>(val.Int(), false)); break;
 				case Type::CharArr: val = Value(std::vector<short>(val.Int(), (short)0)); break;
 				case Type::StringArr: val = Value(std::vector<std::string>(val.Int(), "")); break;
+				case Type::Bytes: val = Value(std::vector<uint8_t>(val.Int(), (uint8_t)0)); break;
 				case Type::StructArr:
 				{
 					std::string structIdentifier = *readConstant().String();
@@ -581,6 +589,8 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 			Type varType = locals.at(unit).at(varName).type();
 			if (isArr(varType) && val.type() == Type::Int)
 			{
+				if (val.Int() < 0)
+					throw runtime_error(u8"Ein Array kann nicht weniger als 0 Elemente enthalten!");
 				switch (varType)
 				{
 				case Type::IntArr: val = Value(std::vector<int>(val.Int(), 0)); break;
@@ -588,6 +598,7 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 				case Type::BoolArr: val = Value(std::vector<bool>(val.Int(), false)); break;
 				case Type::CharArr: val = Value(std::vector<short>(val.Int(), (short)0)); break;
 				case Type::StringArr: val = Value(std::vector<std::string>(val.Int(), "")); break;
+				case Type::Bytes: val = Value(std::vector<uint8_t>(val.Int(), (uint8_t)0)); break;
 				case Type::StructArr:
 				{
 					std::string structIdentifier = *readConstant().String();
@@ -602,6 +613,7 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 		case op::GET_GLOBAL:
 		{
 			std::string varName = *readConstant().String();
+			auto lock = readGlobals();
 			push(globals->at(varName));
 			break;
 		}
@@ -610,6 +622,7 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 			std::string varName = *readConstant().String();
 			std::string memberName = *readConstant().String();
 			uint8_t n = readByte();
+			auto lock = readGlobals();
 			Value struc = globals->at(varName);
 			for (int i = 0; i < n; i++)
 			{
@@ -624,6 +637,7 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 			std::string memberName = *readConstant().String();
 			int index = pop().Int();
 			uint8_t n = readByte();
+			auto lock = readGlobals();
 			Value struc = globals->at(varName).StructArr()->at(index);
 			for (int i = 0; i < n; i++)
 			{
@@ -672,6 +686,7 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 		{
 			std::string arrName = *readConstant().String();
 			int index = pop().Int();
+			auto lock = readGlobals();
 			switch (globals->at(arrName).type())
 			{
 			case Type::IntArr: validateArray(globals->at(arrName).IntArr(), index); push(Value(globals->at(arrName).IntArr()->at(index))); break;
@@ -680,6 +695,7 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 			case Type::CharArr: validateArray(globals->at(arrName).CharArr(), index); push(Value(globals->at(arrName).CharArr()->at(index))); break;
 			case Type::StringArr: validateArray(globals->at(arrName).StringArr(), index); push(Value(globals->at(arrName).StringArr()->at(index))); break;
 			case Type::StructArr: validateArray(globals->at(arrName).StructArr(), index); push(Value(globals->at(arrName).StructArr()->at(index))); break;
+			case Type::Bytes: validateArray(globals->at(arrName).Bytes(), index); push(Value((int)globals->at(arrName).Bytes()->at(index))); break;
 			default: throw runtime_error("Tried to index non-Array!");
 			}
 			break;
@@ -697,21 +713,46 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 			case Type::CharArr: validateArray(locals.at(unit).at(arrName).CharArr(), index); push(Value(locals.at(unit).at(arrName).CharArr()->at(index))); break;
 			case Type::StringArr: validateArray(locals.at(unit).at(arrName).StringArr(), index); push(Value(locals.at(unit).at(arrName).StringArr()->at(index))); break;
 			case Type::StructArr: validateArray(locals.at(unit).at(arrName).StructArr(), index); push(Value(locals.at(unit).at(arrName).StructArr()->at(index))); break;
+			case Type::Bytes: validateArray(locals.at(unit).at(arrName).Bytes(), index); push(Value((int)locals.at(unit).at(arrName).Bytes()->at(index))); break;
 			default: throw runtime_error("Tried to index non-Array!");
 			}
 			break;
 		}
+		case op::SLICE:
+		{
+			std::string arrName = *readConstant().String();
+			int end = pop().Int();
+			int start = pop().Int();
+			auto lock = readGlobals();
+			push(slice(globals->at(arrName), start, end));
+			break;
+		}
+		case op::SLICE_LOCAL:
+		{
+			std::string arrName = *readConstant().String();
+			int unit = readConstant().Int();
+			int end = pop().Int();
+			int start = pop().Int();
+			push(slice(locals.at(unit).at(arrName), start, end));
+			break;
+		}
 		case op::SET_GLOBAL:
 		{
 			std::string varName = *readConstant().String();
+			if (ThreadPool::isWorker()) //a function called from a parallel fr body
+				throw runtime_error(u8"In einer parallelen fr Anweisung knnen keine globalen Variablen verndert werden!");
+			auto lock = writeGlobals();
 			(*globals)[varName] = std::move(peek(0));
 			break;
 		}
 		case op::SET_MEMBER_GLOBAL:
 		{
 			std::string varName = *readConstant().String();
+			if (ThreadPool::isWorker())
+				throw runtime_error(u8"In einer parallelen fr Anweisung knnen keine globalen Variablen verndert werden!");
 			std::string memberName = *readConstant().String();
 			uint8_t n = readByte();
+			auto lock = writeGlobals();
 			Value struc = globals->at(varName);
 			for (int i = 0; i < n; i++)
 			{
@@ -723,10 +764,13 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 		case op::SET_MEMBER_ARRAY_GLOBAL:
 		{
 			std::string varName = *readConstant().String();
+			if (ThreadPool::isWorker() && !parallelBody) //the body itself was checked by the compiler
+				throw runtime_error(u8"In einer parallelen fr Anweisung knnen keine globalen Variablen verndert werden!");
 			std::string memberName = *readConstant().String();
 			Value val = pop();
 			int index = peek(0).Int();
 			uint8_t n = readByte();
+			auto lock = writeGlobals();
 			Value::Struct& struc = (*globals)[varName].StructArr()->operator[](index);
 			for (int i = 0; i < n; i++)
 			{
@@ -772,11 +816,61 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 			struc.fields[memberName] = val;
 			break;
 		}
+		case op::APPEND:
+		{
+			std::string arrName = *readConstant().String();
+			if (ThreadPool::isWorker())
+				throw runtime_error(u8"In einer parallelen fr Anweisung knnen keine globalen Variablen verndert werden!");
+			Value val = pop();
+			bool shared = readByte();
+			auto lock = writeGlobals();
+			Value& arr = globals->at(arrName);
+			if (shared)
+				arr = copyOfArray(arr);
+			Natives::appendToArray(arr, val);
+			push(arr);
+			break;
+		}
+		case op::APPEND_LOCAL:
+		{
+			std::string arrName = *readConstant().String();
+			int unit = readConstant().Int();
+			Value val = pop();
+			Value& arr = locals.at(unit).at(arrName);
+			if (readByte()) //another variable may hold the array, it keeps the old elements like with 'arr plus x'
+				arr = copyOfArray(arr);
+			Natives::appendToArray(arr, val);
+			push(arr);
+			break;
+		}
+		case op::APPEND_STRING:
+		{
+			std::string varName = *readConstant().String();
+			if (ThreadPool::isWorker())
+				throw runtime_error(u8"In einer parallelen fr Anweisung knnen keine globalen Variablen verndert werden!");
+			Value val = pop();
+			auto lock = writeGlobals();
+			appendText(*globals->at(varName).String(), val);
+			push(Value()); //the statement pops it, pushing the Text would copy it
+			break;
+		}
+		case op::APPEND_STRING_LOCAL:
+		{
+			std::string varName = *readConstant().String();
+			int unit = readConstant().Int();
+			Value val = pop();
+			appendText(*locals.at(unit).at(varName).String(), val);
+			push(Value());
+			break;
+		}
 		case op::SET_ARRAY_ELEMENT:
 		{
 			std::string arrName = *readConstant().String();
+			if (ThreadPool::isWorker() && !parallelBody) //the body itself only writes the element of its iteration
+				throw runtime_error(u8"In einer parallelen fr Anweisung knnen keine globalen Variablen verndert werden!");
 			Value val = std::move(pop());
 			int index = peek(0).Int();
+			auto lock = writeGlobals();
 			switch (globals->at(arrName).type())
 			{
 			case Type::IntArr: validateArray(globals->at(arrName).IntArr(), index); (*(globals->at(arrName).IntArr()))[index] = val.Int(); break;
@@ -785,6 +879,7 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 			case Type::CharArr: validateArray(globals->at(arrName).CharArr(), index); (*(globals->at(arrName).CharArr()))[index] = val.Char(); break;
 			case Type::StringArr: validateArray(globals->at(arrName).StringArr(), index); (*(globals->at(arrName).StringArr()))[index] = *val.String(); break;
 			case Type::StructArr: validateArray(globals->at(arrName).StructArr(), index); (*(globals->at(arrName).StructArr()))[index] = *val.VStruct(); break;
+			case Type::Bytes: validateArray(globals->at(arrName).Bytes(), index); (*(globals->at(arrName).Bytes()))[index] = (uint8_t)val.Int(); break;
 			default: throw runtime_error("Tried to index non-Array!");
 			}
 			break;
@@ -803,10 +898,163 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 			case Type::CharArr: validateArray(locals.at(unit).at(arrName).CharArr(), index); (*(locals.at(unit).at(arrName).CharArr()))[index] = val.Char(); break;
 			case Type::StringArr: validateArray(locals.at(unit).at(arrName).StringArr(), index); (*(locals.at(unit).at(arrName).StringArr()))[index] = *val.String(); break;
 			case Type::StructArr: validateArray(locals.at(unit).at(arrName).StructArr(), index); (*(locals.at(unit).at(arrName).StructArr()))[index] = *val.VStruct(); break;
+			case Type::Bytes: validateArray(locals.at(unit).at(arrName).Bytes(), index); (*(locals.at(unit).at(arrName).Bytes()))[index] = (uint8_t)val.Int(); break;
 			default: throw runtime_error("Tried to index non-Array!");
 			}
 			break;
 		}
+		case op::GET_MATRIX_ELEMENT:
+		{
+			std::string matrixName = *readConstant().String();
+			int col = pop().Int();
+			int row = pop().Int();
+			auto lock = readGlobals();
+			push(Value(matrixElement(globals->at(matrixName).VMatrix(), row, col)));
+			break;
+		}
+		case op::GET_MATRIX_ELEMENT_LOCAL:
+		{
+			std::string matrixName = *readConstant().String();
+			int unit = readConstant().Int();
+			int col = pop().Int();
+			int row = pop().Int();
+			push(Value(matrixElement(locals.at(unit).at(matrixName).VMatrix(), row, col)));
+			break;
+		}
+		case op::SET_MATRIX_ELEMENT:
+		{
+			std::string matrixName = *readConstant().String();
+			if (ThreadPool::isWorker() && !parallelBody)
+				throw runtime_error(u8"In einer parallelen fr Anweisung knnen keine globalen Variablen verndert werden!");
+			Value val = std::move(pop());
+			int col = pop().Int();
+			int row = peek(0).Int();
+			auto lock = writeGlobals();
+			matrixElement(globals->at(matrixName).VMatrix(), row, col) = val.Double();
+			break;
+		}
+		case op::SET_MATRIX_ELEMENT_LOCAL:
+		{
+			std::string matrixName = *readConstant().String();
+			int unit = readConstant().Int();
+			Value val = std::move(pop());
+			int col = pop().Int();
+			int row = peek(0).Int();
+			matrixElement(locals.at(unit).at(matrixName).VMatrix(), row, col) = val.Double();
+			break;
+		}
+		case op::GET_DICT_ELEMENT:
+		{
+			std::string dictName = *readConstant().String();
+			Type expected = (Type)readByte();
+			Value key = pop();
+			auto lock = readGlobals();
+			push(dictionaryValue(globals->at(dictName).VDictionary(), key, expected));
+			break;
+		}
+		case op::GET_DICT_ELEMENT_LOCAL:
+		{
+			std::string dictName = *readConstant().String();
+			int unit = readConstant().Int();
+			Type expected = (Type)readByte();
+			Value key = pop();
+			push(dictionaryValue(locals.at(unit).at(dictName).VDictionary(), key, expected));
+			break;
+		}
+		case op::SET_DICT_ELEMENT:
+		{
+			std::string dictName = *readConstant().String();
+			if (ThreadPool::isWorker()) //a function called from a parallel fr body, the iterations would insert at the same time
+				throw runtime_error(u8"In einer parallelen fr Anweisung knnen keine globalen Wrterbcher verndert werden!");
+			Value val = std::move(pop());
+			auto lock = writeGlobals();
+			globals->at(dictName).VDictionary()->set(stackTop[-1], std::move(val)); //the key stays on the stack
+			break;
+		}
+		case op::SET_DICT_ELEMENT_LOCAL:
+		{
+			std::string dictName = *readConstant().String();
+			int unit = readConstant().Int();
+			Value val = std::move(pop());
+			locals.at(unit).at(dictName).VDictionary()->set(stackTop[-1], std::move(val));
+			break;
+		}
+		case op::REMOVE_KEY:
+		{
+			std::string dictName = *readConstant().String();
+			if (ThreadPool::isWorker())
+				throw runtime_error(u8"In einer parallelen fr Anweisung knnen keine globalen Wrterbcher verndert werden!");
+			Value key = pop();
+			auto lock = writeGlobals();
+			globals->at(dictName).VDictionary()->remove(key);
+			break;
+		}
+		case op::REMOVE_KEY_LOCAL:
+		{
+			std::string dictName = *readConstant().String();
+			int unit = readConstant().Int();
+			Value key = pop();
+			locals.at(unit).at(dictName).VDictionary()->remove(key);
+			break;
+		}
+		case op::CONTAINS_KEY:
+		{
+			Value key = pop();
+			Value dictionary = pop();
+			auto lock = readGlobals(); //the Woerterbuch might be a global one
+			push(Value(dictionary.VDictionary()->find(key) != nullptr));
+			break;
+		}
+		case op::DICTIONARY_KEYS:
+		{
+			Type keyType = (Type)readByte();
+			Value dictionary = pop();
+			auto lock = readGlobals();
+			Dictionary& dict = *dictionary.VDictionary();
+			auto checkKey = [keyType](Value& key) {
+				if (key.type() != keyType)
+					throw runtime_error(u8"Das Wrterbuch enthlt Schlssel, die nicht den Typ der Zhl Variable haben!");
+			};
+			if (keyType == Type::String)
+			{
+				std::vector<std::string> keys;
+				keys.reserve(dict.size());
+				dict.forEach([&](Value& key, Value&) { checkKey(key); keys.push_back(*key.String()); });
+				push(Value(std::move(keys)));
+			}
+			else
+			{
+				std::vector<int> keys;
+				keys.reserve(dict.size());
+				dict.forEach([&](Value& key, Value&) { checkKey(key); keys.push_back(key.Int()); });
+				push(Value(std::move(keys)));
+			}
+			break;
+		}
+		case op::NEXT_KEY:
+		{
+			std::string keysName = *readConstant().String();
+			std::string positionName = *readConstant().String();
+			std::string keyName = *readConstant().String();
+			int unit = readConstant().Int();
+			std::unordered_map<std::string, Value>& unitLocals = locals.at(unit);
+			Value& keys = unitLocals.at(keysName);
+			int& position = unitLocals.at(positionName).Int();
+			bool hasNext;
+			if (keys.type() == Type::StringArr)
+			{
+				hasNext = position < (int)keys.StringArr()->size();
+				if (hasNext) unitLocals[keyName] = Value((*keys.StringArr())[position]);
+			}
+			else
+			{
+				hasNext = position < (int)keys.IntArr()->size();
+				if (hasNext) unitLocals[keyName] = Value((*keys.IntArr())[position]);
+			}
+			if (hasNext) position++;
+			push(Value(hasNext));
+			break;
+		}
 		case op::JUMP_IF_FALSE:
 		{
 			uint16_t offset = readShort();
@@ -830,18 +1078,27 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 			if (returnType.type != Type::None) return pop();
 			return Value();
 		}
+		case op::CHECK_GLOBAL_WRITE:
+		{
+			if (ThreadPool::isWorker() && !parallelBody)
+				throw runtime_error(u8"In einer parallelen fr Anweisung knnen keine globalen Variablen verndert werden!");
+			break;
+		}
 		case op::CALL:
 		{
 			std::string funcName = *readConstant().String();
-			Function func;
+			Function* callee;
 			try
 			{
-				func = functions->at(funcName);
+				callee = &functions->at(funcName);
 			}
 			catch (std::exception)
 			{
 				throw runtime_error("Die Funktion '" + funcName + "' ist nicht definiert!");
 			}
+			if (callee->lazyCompiler != nullptr && !callee->lazyCompiler->compileFunction(funcName))
+				throw runtime_error("Die Funktion '" + funcName + "' konnte nicht kompiliert werden!");
+			Function func = *callee;
 			if (func.native != nullptr)
 			{
 				std::vector<Value> args;
@@ -850,18 +1107,7 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 				{
 					args[i] = std::move(pop());
 				}
-				try
-				{
-					push(func.runNative(globals, functions, structs, std::move(args)));
-				}
-				catch (runtime_error& e)
-				{
-					throw e;
-				}
-				catch (std::exception&)
-				{
-					throw runtime_error("Falsche Nutzung einer eingebauten Funktion!");
-				}
+				push(func.callNative(globals, functions, structs, runtime, std::move(args)));
 				break;
 			}
 
@@ -869,16 +1115,104 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 			{
 				func.locals.at(func.argUnit)[func.args.at(i).first] = pop();
 			}
-			push(func.run(globals, functions, structs));
+			push(func.run(globals, functions, structs, runtime));
+			break;
+		}
+		case op::START_TASK:
+		{
+			std::string funcName = *readConstant().String();
+			if (ThreadPool::isWorker())
+				throw runtime_error(u8"In einer parallelen fr Anweisung knnen keine Aufgaben gestartet werden!");
+			auto it = functions->find(funcName);
+			if (it == functions->end())
+				throw runtime_error("Die Funktion '" + funcName + "' ist nicht definiert!");
+			compileAll(); //compiling on the first call would change the functions while the tasks read them
+
+			//the task gets its own copy of the function like a call does, only the byte code is shared
+			Function func = it->second;
+			std::vector<Value> args(func.args.size());
+			for (int i = func.args.size() - 1; i >= 0; i--)
+			{
+				args[i] = pop();
+			}
+			int id = runtime->tasks.start([func, args = std::move(args), globals = globals, functions = functions, structs = structs, runtime = runtime]() mutable
+			{
+				if (func.native != nullptr)
+					return func.callNative(globals, functions, structs, runtime, std::move(args));
+				for (size_t i = 0; i < args.size(); i++)
+				{
+					func.locals.at(func.argUnit)[func.args.at(i).first] = std::move(args[i]);
+				}
+				return func.run(globals, functions, structs, runtime);
+			});
+			push(Value(id));
+			break;
+		}
+		case op::AWAIT:
+		{
+			Type expected = (Type)readByte();
+			if (ThreadPool::isWorker())
+				throw runtime_error(u8"In einer parallelen fr Anweisung kann nicht auf Aufgaben gewartet werden!");
+			Value result = runtime->tasks.wait(pop().Int());
+			if (expected == Type::None)
+			{
+				push(Value());
+				break;
+			}
+			if (result.type() != expected)
+				throw runtime_error(u8"Das Ergebnis der Aufgabe hat nicht den erwarteten Typ!");
+			push(std::move(result));
+			break;
+		}
+		case op::RECEIVE:
+		{
+			Type expected = (Type)readByte();
+			Channel& channel = runtime->channels.get(pop().Int());
+			Value value;
+			if (!channel.tryReceive(value))
+			{
+				TaskPool::Blocking blocking(runtime->tasks); //the sender might be a task that still waits for a thread
+				if (!channel.receive(value))
+					throw runtime_error(u8"Der Kanal ist geschlossen und es gibt keine Werte mehr zu empfangen!");
+			}
+			if (value.type() != expected)
+				throw runtime_error(u8"Der empfangene Wert hat nicht den erwarteten Typ!");
+			push(std::move(value));
 			break;
 		}
 		case op::POP: pop(); break;
 		case op::FORPREP: forPrep = true; break;
 		case op::FORDONE: forPrep = false; break;
+		case op::FOR_CONDITION:
+		{
+			std::string directionName = *readConstant().String();
+			int unit = readConstant().Int();
+			int to = pop().Int();
+			int counter = pop().Int();
+			if (forPrep) locals.at(unit)[directionName] = Value(counter > to);
+			bool down = locals.at(unit).at(directionName).Bool();
+			push(Value(down ? counter >= to : counter <= to));
+			break;
+		}
+		case op::PARALLEL_FOR:
+		{
+			std::string counter = *readConstant().String();
+			int unit = readConstant().Int();
+			uint16_t bodyLength = readShort();
+			int step = pop().Int();
+			int to = pop().Int();
+			int from = pop().Int();
+
+			size_t bodyStart = ip - chunk->bytes.begin();
+			parallelFor(bodyStart, counter, unit, from, to, step);
+			ip = chunk->bytes.begin() + bodyStart + bodyLength;
+			break;
+		}
+		case op::PARALLEL_END: return Value();
 #ifndef NDEBUG
 		case op::PRINT:
 		{
-			pop().print(std::cout);
+			pop().print(runtime->out);
 			break;
 		}
 #endif
@@ -894,13 +1228,126 @@ Value Function::run(std::unordered_map<std::string, Value>* globals,
 Value Function::runNative(std::unordered_map<std::string, Value>* globals,
 	std::unordered_map<std::string, Function>* functions,
 	std::unordered_map<std::string, Value::Struct>* structs,
+	Natives::Runtime* runtime,
 	std::vector<Value> args)
 {
 	this->globals = globals;
 	this->functions = functions;
 	this->structs = structs;
+	this->runtime = runtime;
+
+	return (*native)(*runtime, std::move(args));
+}
+
+Value Function::callNative(std::unordered_map<std::string, Value>* globals,
+	std::unordered_map<std::string, Function>* functions,
+	std::unordered_map<std::string, Value::Struct>* structs,
+	Natives::Runtime* runtime,
+	std::vector<Value> args)
+{
+	try
+	{
+		return runNative(globals, functions, structs, runtime, std::move(args));
+	}
+	catch (runtime_error& e)
+	{
+		throw e;
+	}
+	catch (std::exception&)
+	{
+		throw runtime_error("Falsche Nutzung einer eingebauten Funktion!");
+	}
+}
+
+void Function::compileAll()
+{
+	for (auto& [name, function] : *functions)
+	{
+		if (function.lazyCompiler != nullptr && !function.lazyCompiler->compileFunction(name))
+			throw runtime_error("Die Funktion '" + name + "' konnte nicht kompiliert werden!");
+	}
+}
+
+Value& Function::dictionaryValue(Dictionary* dictionary, Value& key, Type expected)
+{
+	Value* value = dictionary->find(key);
+	if (value == nullptr)
+	{
+		std::stringstream ss;
+		key.print(ss);
+		throw runtime_error(u8"Das Wrterbuch enthlt den Schlssel '" + ss.str() + u8"' nicht!");
+	}
+	if (value->type() != expected)
+		throw runtime_error(u8"Der Wert im Wrterbuch hat nicht den erwarteten Typ!");
+	return *value;
+}
 
-	return (*native)(std::move(args));
+std::shared_lock<std::shared_mutex> Function::readGlobals()
+{
+	//without tasks only the thread running the program writes the globals
+	if (!runtime->tasks.started()) return std::shared_lock<std::shared_mutex>();
+	return std::shared_lock<std::shared_mutex>(runtime->globalsLock);
+}
+
+std::unique_lock<std::shared_mutex> Function::writeGlobals()
+{
+	if (!runtime->tasks.started()) return std::unique_lock<std::shared_mutex>();
+	return std::unique_lock<std::shared_mutex>(runtime->globalsLock);
+}
+
+void Function::parallelFor(size_t bodyStart, const std::string& counter, int unit, int from, int to, int step)
+{
+	if (step == 0)
+		throw runtime_error(u8"Die Schrittgre einer parallelen fr Anweisung darf nicht 0 sein!");
+	int64_t count = 0;
+	if (step > 0 && from <= to) count = ((int64_t)to - from) / step + 1;
+	else if (step < 0 && from >= to) count = ((int64_t)from - to) / -(int64_t)step + 1;
+	if (count == 0) return;
+	if (count > UINT32_MAX)
+		throw runtime_error(u8"Zu viele Durchlufe in einer parallelen fr Anweisung!");
+
+	compileAll(); //compiling on the first call would change the functions while the threads read them
+
+	//every thread works on its own copy of the function like a call does, so the variables of the body are private to it
+	auto makeWorker = [this]()
+	{
+		Function worker = *this;
+		worker.stack = std::vector<Value>(StackMax);
+		return worker;
+	};
+
+	//a function with a parallel fr loop called from a parallel fr body, the cores are already busy.
+	//It is not a parallelBody, its body may not write the globals the outer iterations share
+	if (ThreadPool::isWorker())
+	{
+		makeWorker().runIterations(bodyStart, counter, unit, from, step, 0, (uint32_t)count);
+		return;
+	}
+
+	std::vector<Function> workers;
+	workers.reserve(runtime->threads.size());
+	for (size_t i = 0; i < runtime->threads.size(); i++)
+	{
+		workers.push_back(makeWorker());
+		workers.back().parallelBody = true;
+	}
+
+	runtime->threads.forEach((uint32_t)count, [&](size_t worker, uint32_t begin, uint32_t end)
+	{
+		workers[worker].runIterations(bodyStart, counter, unit, from, step, begin, end);
+	});
+}
+
+void Function::runIterations(size_t bodyStart, const std::string& counter, int unit, int from, int step, uint32_t begin, uint32_t end)
+{
+	std::unordered_map<std::string, Value>& unitLocals = locals.at(unit);
+	for (uint32_t i = begin; i < end; i++)
+	{
+		unitLocals[counter] = Value((int)(from + (int64_t)i * step));
+		ip = chunk->bytes.begin() + bodyStart;
+		stackTop = stack.begin();
+		execute();
+	}
 }
 
 void Function::push(Value value)
@@ -914,7 +1361,7 @@ void Function::push(Value value)
 Value Function::pop()
 {
 	--stackTop;
-	return *stackTop;
+	return std::move(*stackTop);
 }
 
 Value Function::peek(int distance)
@@ -934,9 +1381,62 @@ uint16_t Function::readShort()
 	return (ip += 2, (uint16_t)((ip[-2] << 8) | ip[-1]));
 }
 
-Value Function::readConstant()
+Value& Function::readConstant()
+{
+	return chunk->constants[readShort()];
+}
+
+void Function::appendText(std::string& text, Value& value)
+{
+	char buff[Value::NumberBufferSize];
+	switch (value.type())
+	{
+	case Type::Int: text.append(buff, Value::FormatInt(buff, value.Int())); break;
+	case Type::Double: text.append(buff, Value::FormatDouble(buff, value.Double())); break;
+	case Type::Char: text += Value::U8CharToString(value.Char()); break;
+	case Type::String: text += *value.String(); break;
+	}
+}
+
+//copy the elements start to end (both included) of vec at once, end may be start - 1 for an empty slice
+template<typename T>
+static std::vector<T> sliceOf(std::vector<T> const* vec, int start, int end)
+{
+	if (start < 0 || end >= (int)vec->size())
+		throw runtime_error(u8"Es wurde versucht auf ein Array Element auerhalb der Reichweite zuzugreifen!");
+	if (end < start - 1)
+		throw runtime_error(u8"Das Ende eines Teil-Arrays darf nicht vor seinem Anfang liegen!");
+	return std::vector<T>(vec->begin() + start, vec->begin() + end + 1);
+}
+
+Value Function::copyOfArray(Value& arr)
 {
-	return chunk.constants[readShort()];
+	switch (arr.type())
+	{
+	case Type::IntArr: return Value(*arr.IntArr());
+	case Type::DoubleArr: return Value(*arr.DoubleArr());
+	case Type::BoolArr: return Value(*arr.BoolArr());
+	case Type::CharArr: return Value(*arr.CharArr());
+	case Type::StringArr: return Value(*arr.StringArr());
+	case Type::StructArr: return Value(*arr.StructArr());
+	case Type::Bytes: return Value(*arr.Bytes());
+	default: throw runtime_error("Tried to copy non-Array!");
+	}
+}
+
+Value Function::slice(Value& arr, int start, int end)
+{
+	switch (arr.type())
+	{
+	case Type::IntArr: return Value(sliceOf(arr.IntArr(), start, end));
+	case Type::DoubleArr: return Value(sliceOf(arr.DoubleArr(), start, end));
+	case Type::BoolArr: return Value(sliceOf(arr.BoolArr(), start, end));
+	case Type::CharArr: return Value(sliceOf(arr.CharArr(), start, end));
+	case Type::StringArr: return Value(sliceOf(arr.StringArr(), start, end));
+	case Type::StructArr: return Value(sliceOf(arr.StructArr(), start, end));
+	case Type::Bytes: return Value(sliceOf(arr.Bytes(), start, end));
+	default: throw runtime_error("Tried to slice non-Array!");
+	}
 }
 
 void Function::addition()
@@ -961,7 +1461,7 @@ void Function::addition()
 			push(Value((a.Int() + b.Char())));
 			return;
 		case Type::String:
-			push(Value(std::string(std::to_string(a.Int()) + *b.String())));
+			push(Value(Value::IntToString(a.Int()) + *b.String()));
 			return;
 		}
 	case Type::Double:
@@ -977,9 +1477,7 @@ void Function::addition()
 			push(Value(((int)a.Double() + (int)b.Char())));
 			return;
 		case Type::String:
-			std::string astr(std::to_string(a.Double()));
-			astr.replace(astr.begin(), astr.end(), '.', ',');
-			push(Value(astr + *b.String()));
+			push(Value(Value::DoubleToString(a.Double()) + *b.String()));
 			return;
 		}
 	case Type::Char:
@@ -1002,15 +1500,11 @@ void Function::addition()
 		switch (bType)
 		{
 		case Type::Int:
-			push(Value(*a.String() + std::to_string(b.Int())));
+			push(Value(*a.String() + Value::IntToString(b.Int())));
 			return;
 		case Type::Double:
-		{
-			std::string str(std::to_string(b.Double()));
-			std::replace(str.begin(), str.end(), '.', ',');
-			push(Value(*a.String() + str));
+			push(Value(*a.String() + Value::DoubleToString(b.Double())));
 			return;
-		}
 		case Type::Char:
 			push(Value(*a.String() + Value::U8CharToString(b.Char())));
 			return;
@@ -1046,7 +1540,7 @@ void Function::addition()
 		switch (bType)
 		{
 		case Type::Double:
-			vec.push_back(b.Int());
+			vec.push_back(b.Double());
 			push(Value(vec));
 			return;
 		case Type::DoubleArr:
@@ -1120,5 +1614,22 @@ void Function::addition()
 			return;
 		}
 	}
+	case Type::Bytes:
+	{
+		std::vector<uint8_t> vec = *a.Bytes();
+		switch (bType)
+		{
+		case Type::Int:
+			vec.push_back((uint8_t)b.Int());
+			push(Value(std::move(vec)));
+			return;
+		case Type::Bytes:
+			vec.insert(vec.end(), b.Bytes()->begin(), b.Bytes()->end());
+			push(Value(std::move(vec)));
+			return;
+		default:
+			return;
+		}
+	}
 	}
 }
\ No newline at end of file
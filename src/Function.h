@@ -2,8 +2,13 @@
 
 #include "Chunk.h"
 #include "Natives.h"
+#include "Dictionary.h"
 #include <unordered_map>
 #include <array>
+#include <mutex>
+#include <shared_mutex>
+
+class Compiler;
 
 class Function
 {
@@ -16,12 +21,31 @@ private:
 	//run the functions byte-code and return it's result. If the return type is ValueType::None the return Value should be discarded
 	Value run(std::unordered_map<std::string, Value>* globals,
 		std::unordered_map<std::string, Function>* functions,
-		std::unordered_map<std::string, Value::Struct>* structs); //only the VirtualMachine should call this function
+		std::unordered_map<std::string, Value::Struct>* structs,
+		Natives::Runtime* runtime); //only the VirtualMachine should call this function
 	Value runNative(std::unordered_map<std::string, Value>* globals,
 		std::unordered_map<std::string, Function>* functions,
 		std::unordered_map<std::string, Value::Struct>* structs,
+		Natives::Runtime* runtime,
+		std::vector<Value> args);
+	//runNative, but every exception that is not a runtime_error becomes one
+	Value callNative(std::unordered_map<std::string, Value>* globals,
+		std::unordered_map<std::string, Function>* functions,
+		std::unordered_map<std::string, Value::Struct>* structs,
+		Natives::Runtime* runtime,
 		std::vector<Value> args);
 
+	Value execute(); //the interpreter loop of run, returns at RETURN, the end of the chunk and PARALLEL_END
+	//run the body of a parallel fr loop, that starts at bodyStart in chunk, for every value of counter on all cores
+	void parallelFor(size_t bodyStart, const std::string& counter, int unit, int from, int to, int step);
+	void runIterations(size_t bodyStart, const std::string& counter, int unit, int from, int step, uint32_t begin, uint32_t end); //run the iterations [begin, end) of a parallel fr body on this copy of the function
+
+	void compileAll(); //compile the bodies of all functions that were not called yet, before other threads run them
+
+	//lock the global variables once tasks might use them at the same time
+	std::shared_lock<std::shared_mutex> readGlobals();
+	std::unique_lock<std::shared_mutex> writeGlobals();
+
 	//these functions are only needed during runtime
 	void push(Value value); //push a value onto the stack
 	Value pop(); //pop a Value of the stack
@@ -29,9 +53,10 @@ private:
 
 	uint8_t readByte(); //read the next byte in chunk.bytes
 	uint16_t readShort(); //read the next 2 bytes in chunk.bytes as short
-	Value readConstant(); //read the next byte in chunk.bytes and lookup the constant it indicates
+	Value& readConstant(); //read the next byte in chunk.bytes and lookup the constant it indicates
 	
 	void addition(); //seperate function for  the OpCode::Add case in run
+	static void appendText(std::string& text, Value& value); //the Text cases of addition, but in place
 
 	template<typename T>
 	void validateArray(std::vector<T> const* vec, int index)
@@ -39,17 +64,44 @@ private:
 		if (index >= vec->size())
 			throw runtime_error("Es wurde versucht auf ein Array Element auerhalb der Reichweite zuzugreifen!");
 	}
+	static Value slice(Value& arr, int start, int end); //a new array with the elements start to end (both included) of arr
+	static Value copyOfArray(Value& arr); //a new array with all elements of arr
+	double& matrixElement(Value::Matrix* matrix, int row, int col)
+	{
+		if ((unsigned)row >= (unsigned)matrix->rows || (unsigned)col >= (unsigned)matrix->cols)
+			throw runtime_error(u8"Es wurde versucht auf ein Matrix Element auerhalb der Reichweite zuzugreifen!");
+		return matrix->data[(size_t)row * matrix->cols + col];
+	}
+	Value& dictionaryValue(Dictionary* dictionary, Value& key, Type expected); //the value of key, an error if there is none or it has another type
 public:
 	std::vector<std::pair<std::string, ValueType>> args; //the types and count of the arguments the function takes (none for the main function)
 	int argUnit;
 	bool returned;
-	Chunk chunk; //holds the byte code of the function
+	std::shared_ptr<Chunk> chunk; //holds the byte code of the function. Never changed at runtime, so all copies of the function share it
 	ValueType returnType; //the return type of the function
 	std::unordered_map<int, std::unordered_map<std::string, Value>> locals; //local variables of the function mapped to the numner their scope unit appeared at. At compile-time the values are empty.
 public:
-	using NativePtr = Value(*)(std::vector<Value>);
+	using NativePtr = Value(*)(Natives::Runtime&, std::vector<Value>);
 	NativePtr native; //the native function, nullptr if the function is not a native
 	std::vector<Natives::CombineableValueType> nativeArgs; //the types of the arguments the function takes if it is a native. only used at compile time
+	//how the compiler finds the type a native returns
+	enum class NativeReturn
+	{
+		Declared, //always returnType
+		FirstArg, //the type of the first argument
+		FirstArgElement, //the element type of the first argument, which is an array
+	};
+	NativeReturn nativeReturn; //only used at compile time
+	//what a native does with its arguments besides reading them
+	enum class ArgUse
+	{
+		Read, //nothing
+		ChangesFirst, //it changes the first argument in place and gives it back
+		Keeps, //it keeps them after it returned, like a channel
+	};
+	ArgUse argUse; //only used at compile time
+	bool returnsShared; //the result may share its array, struct, Matrix or Wrterbuch with a global variable. only used at compile time
+	Compiler* lazyCompiler; //the compiler that still has to compile the body of this function on its first call, nullptr if it is already compiled
 private:
 	//Stuff needed during runtime, be carefull here, this should only be touched through it's getter functions
 	static constexpr size_t StackMax = 1024; //the maximum count of the stack
@@ -61,5 +113,7 @@ private:
 	std::unordered_map<std::string, Value>* globals; //pointer to the global variables map
 	std::unordered_map<std::string, Function>* functions; //pointer to the map of functions
 	std::unordered_map<std::string, Value::Struct>* structs; //pointer to the map of structs
+	Natives::Runtime* runtime; //pointer to the state of the natives
+	bool parallelBody; //true for the copies that run the iterations of a parallel fr body, false for the functions they call
 };
 
@@ -0,0 +1,100 @@
+#include "LineReader.h"
+#include <cstring>
+#include <cctype>
+#include <io.h>
+
+LineReader::LineReader(const std::string& path)
+	:
+	file(path, std::ios::binary),
+	fd(-1),
+	begin(0),
+	end(0)
+{}
+
+LineReader::LineReader(int fd)
+	:
+	fd(fd),
+	begin(0),
+	end(0)
+{}
+
+bool LineReader::isOpen() const
+{
+	return fd >= 0 || file.is_open();
+}
+
+bool LineReader::atEnd()
+{
+	return begin == end && !fill();
+}
+
+bool LineReader::nextLine(std::string& line)
+{
+	line.clear();
+	if (atEnd()) return false;
+
+	while (true)
+	{
+		const char* first = buffer.data() + begin;
+		const char* newLine = (const char*)std::memchr(first, '\n', end - begin);
+		if (newLine != nullptr)
+		{
+			line.append(first, newLine);
+			begin += (newLine - first) + 1;
+			break;
+		}
+		//the line goes on in the next block (or is the last one in the file)
+		line.append(first, end - begin);
+		begin = end;
+		if (!fill()) break;
+	}
+
+	//leseDatei opens files in text mode, so lines from \r\n files look the same here
+	if (!line.empty() && line.back() == '\r') line.pop_back();
+	return true;
+}
+
+bool LineReader::nextWord(std::string& word)
+{
+	word.clear();
+	while (true)
+	{
+		for (; begin < end && std::isspace((unsigned char)buffer[begin]); begin++);
+		if (begin < end) break;
+		if (!fill()) return false;
+	}
+
+	while (true)
+	{
+		size_t wordEnd = begin;
+		for (; wordEnd < end && !std::isspace((unsigned char)buffer[wordEnd]); wordEnd++);
+		word.append(buffer.data() + begin, wordEnd - begin);
+		begin = wordEnd;
+		//the word goes on in the next block (or is the last one in the input)
+		if (begin < end || !fill()) return true;
+	}
+}
+
+int LineReader::nextChar()
+{
+	if (atEnd()) return -1;
+	return (unsigned char)buffer[begin++];
+}
+
+bool LineReader::fill()
+{
+	if (buffer.empty()) buffer.resize(BlockSize);
+	begin = 0;
+	end = 0;
+	if (fd >= 0)
+	{
+		int count = _read(fd, buffer.data(), (unsigned int)buffer.size());
+		if (count > 0) end = (size_t)count;
+	}
+	else if (file)
+	{
+		file.read(buffer.data(), buffer.size());
+		end = (size_t)file.gcount();
+	}
+	return end > 0;
+}
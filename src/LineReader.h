@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+//reads a file (or stdin) through one big block buffer, so no matter how big the input is only the current line is held in memory
+class LineReader
+{
+public:
+	LineReader(const std::string& path);
+	LineReader(int fd); //read from an already open file descriptor, like stdin. Reads return as soon as some input is there, so this works on a console too
+
+	bool isOpen() const;
+	bool atEnd(); //true if there is no input left to read
+	bool nextLine(std::string& line); //read the next line without its line ending into line, false if there is none left
+	bool nextWord(std::string& word); //read the next whitespace seperated word into word, false if there is none left
+	int nextChar(); //read the next char, -1 if there is none left
+private:
+	bool fill(); //read the next block into the buffer, false if the input has nothing left
+
+	static constexpr size_t BlockSize = 1 << 20;
+
+	std::ifstream file;
+	int fd; //-1 if file is read
+	std::vector<char> buffer; //allocated on the first read
+	size_t begin; //first unread char in buffer
+	size_t end; //one past the last valid char in buffer
+};
@@ -8,7 +8,15 @@
 #include <streambuf>
 #include "Function.h"
 #include <filesystem>
-#include <random>
+#include <limits>
+#include <io.h>
+#include <cstring>
+#include <numeric>
+#include <climits>
+#include <atomic>
+#include <cmath>
+#include "VectorMath.h"
+#include "Dictionary.h"
 
 #pragma warning (disable : 26812)
 
@@ -34,38 +42,121 @@ namespace Natives
 		case Type::CharArr: return (toCheck & CombineableValueType::CharArr);
 		case Type::StringArr: return (toCheck & CombineableValueType::StringArr);
 		case Type::StructArr: return (toCheck & CombineableValueType::StructArr);
+		case Type::Bytes: return (toCheck & CombineableValueType::Bytes);
+		case Type::Matrix: return (toCheck & CombineableValueType::Matrix);
+		case Type::Dictionary: return (toCheck & CombineableValueType::Dictionary);
 		case Type::Any: return (toCheck & CombineableValueType::Any);
 		case Type::Function: return false;
 		}
 		return false;
 	}
 
-	Value schreibeNative(std::vector<Value> args)
+	Runtime::Runtime(OutputBuffer::FlushPolicy flushPolicy, uint64_t seed)
+		:
+		out(stdout, flushPolicy),
+		in(_fileno(stdin)),
+		random(seed)
+	{}
+
+	Value schreibeNative(Runtime& runtime, std::vector<Value> args)
 	{
-		args.at(0).print(std::cout);
+		std::lock_guard<std::mutex> lock(runtime.outLock);
+		args.at(0).print(runtime.out);
 		return Value();
 	}
 
-	Value schreibeZeileNative(std::vector<Value> args)
+	Value schreibeZeileNative(Runtime& runtime, std::vector<Value> args)
 	{
-		args.at(0).print(std::cout);
-		std::cout << "\n";
+		std::lock_guard<std::mutex> lock(runtime.outLock);
+		args.at(0).print(runtime.out);
+		runtime.out << '\n';
 		return Value();
 	}
 
-	Value leseNative(std::vector<Value> args)
+	//the user should see the prompt before typing
+	static void flushOutput(Runtime& runtime)
+	{
+		std::lock_guard<std::mutex> lock(runtime.outLock);
+		runtime.out.flush();
+	}
+
+	Value leseNative(Runtime& runtime, std::vector<Value> args)
+	{
+		std::lock_guard<std::mutex> lock(runtime.inLock);
+		flushOutput(runtime);
+		return Value((short)runtime.in.nextChar());
+	}
+
+	Value leseZeileNative(Runtime& runtime, std::vector<Value> args)
+	{
+		std::lock_guard<std::mutex> lock(runtime.inLock);
+		flushOutput(runtime);
+		std::string line;
+		runtime.in.nextLine(line);
+		return Value(std::move(line));
+	}
+
+	Value leerePufferNative(Runtime& runtime, std::vector<Value> args)
 	{
-		return Value((short)std::cin.get());
+		flushOutput(runtime);
+		return Value();
 	}
 
-	Value leseZeileNative(std::vector<Value> args)
+	Value leseAlleZeilenNative(Runtime& runtime, std::vector<Value> args)
 	{
+		std::lock_guard<std::mutex> lock(runtime.inLock);
+		flushOutput(runtime);
+		std::vector<std::string> lines;
 		std::string line;
-		std::getline(std::cin, line);
-		return Value(line);
+		while (runtime.in.nextLine(line))
+			lines.push_back(std::move(line));
+		return Value(std::move(lines));
+	}
+
+	Value leseZeilenNative(Runtime& runtime, std::vector<Value> args)
+	{
+		int count = args.at(0).Int();
+		if (count < 0) throw runtime_error("Es knnen keine " + std::to_string(count) + " Zeilen gelesen werden!");
+
+		std::lock_guard<std::mutex> lock(runtime.inLock);
+		flushOutput(runtime);
+		std::vector<std::string> lines;
+		lines.reserve(std::min(count, 1 << 16));
+		std::string line;
+		while ((int)lines.size() < count && runtime.in.nextLine(line))
+			lines.push_back(std::move(line));
+		return Value(std::move(lines));
+	}
+
+	//parse every whitespace seperated word of stdin with parse, without building a Text for each of them first
+	template<typename T, typename Parser>
+	static std::vector<T> readAllNumbers(Runtime& runtime, Parser parse, const char* typeName)
+	{
+		std::lock_guard<std::mutex> lock(runtime.inLock);
+		flushOutput(runtime);
+		std::vector<T> numbers;
+		std::string word;
+		while (runtime.in.nextWord(word))
+		{
+			T number;
+			if (!parse(word, number))
+				throw runtime_error("'" + word + "' kann nicht in eine " + typeName + " umgewandelt werden!");
+			numbers.push_back(number);
+		}
+		return numbers;
+	}
+
+	Value leseAlleZahlenNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return Value(readAllNumbers<int>(runtime, Value::ParseInt, "Zahl"));
+	}
+
+	Value leseAlleKommazahlenNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return Value(readAllNumbers<double>(runtime, Value::ParseDouble, "Kommazahl"));
 	}
 
-	Value existiertDateiNative(std::vector<Value> args)
+	Value existiertDateiNative(Runtime& runtime, std::vector<Value> args)
 	{
 		std::string path = *args.at(0).String();
 		std::ifstream ifs;
@@ -75,9 +166,24 @@ namespace Natives
 		return ret;
 	}
 
-	Value leseDateiNative(std::vector<Value> args)
+	//write everything bearbeiteDatei appended, so the file can be read
+	static void flushOutputFiles(Runtime& runtime)
+	{
+		std::lock_guard<std::mutex> lock(runtime.filesLock);
+		runtime.outputFiles.flushAll();
+	}
+
+	//write everything bearbeiteDatei appended to path and close it, so the file can be replaced
+	static void closeOutputFile(Runtime& runtime, const std::string& path)
+	{
+		std::lock_guard<std::mutex> lock(runtime.filesLock);
+		runtime.outputFiles.close(path);
+	}
+
+	Value leseDateiNative(Runtime& runtime, std::vector<Value> args)
 	{
 		std::string path = *args.at(0).String();
+		flushOutputFiles(runtime); //the file might have been appended to
 
 		std::ifstream ifs;
 		ifs.open(path);
@@ -90,9 +196,10 @@ namespace Natives
 		return Value(file);
 	}
 
-	Value schreibeDateiNative(std::vector<Value> args)
+	Value schreibeDateiNative(Runtime& runtime, std::vector<Value> args)
 	{
 		std::string path = *args.at(0).String();
+		closeOutputFile(runtime, path); //write pending appends before the file is replaced
 
 		std::ofstream ofs(path);
 		if (!ofs.is_open()) throw runtime_error("Die Datei '" + path + "' konnte nicht geffnet werden!");
@@ -104,143 +211,336 @@ namespace Natives
 		return Value();
 	}
 
-	Value bearbeiteDateiNative(std::vector<Value> args)
+	Value bearbeiteDateiNative(Runtime& runtime, std::vector<Value> args)
 	{
 		std::string path = *args.at(0).String();
 
-		if (!std::filesystem::exists(path)) throw runtime_error("Die Datie '" + path + "' existiert nicht und kann somit nicht bearbeitet werden!");
+		//the file stays open for the next call, see OutputFileCache
+		std::lock_guard<std::mutex> lock(runtime.filesLock);
+		std::ofstream* ofs = runtime.outputFiles.get(path);
+		if (ofs == nullptr)
+		{
+			if (!std::filesystem::exists(path)) throw runtime_error("Die Datie '" + path + "' existiert nicht und kann somit nicht bearbeitet werden!");
 
-		std::ofstream ofs;
-		ofs.open(path, std::ofstream::app);
-		if (!ofs.is_open()) throw runtime_error("Die Datei '" + path + "' konnte nicht geffnet werden!");
+			ofs = runtime.outputFiles.open(path);
+			if (ofs == nullptr) throw runtime_error("Die Datei '" + path + "' konnte nicht geffnet werden!");
+		}
 
-		args.at(1).print(ofs);
+		args.at(1).print(*ofs);
 
-		ofs.close();
+		return Value();
+	}
 
+	Value schliesseDateiNative(Runtime& runtime, std::vector<Value> args)
+	{
+		closeOutputFile(runtime, *args.at(0).String());
 		return Value();
 	}
 
-	Value leseBytesNative(std::vector<Value> args)
+	static constexpr size_t ByteBlockSize = 1 << 20; //how many bytes the byte natives read or write at once
+
+	//read count bytes from ifs and append them to out, for Zahlen one block at a time so the bytes are never held twice
+	template<typename T>
+	static void readBytes(std::ifstream& ifs, std::vector<T>& out, size_t count)
 	{
-		std::string path = *args.at(0).String();
+		if constexpr (std::is_same_v<T, uint8_t>)
+		{
+			size_t oldSize = out.size();
+			out.resize(oldSize + count);
+			ifs.read((char*)out.data() + oldSize, count);
+			out.resize(oldSize + (size_t)ifs.gcount());
+		}
+		else
+		{
+			std::vector<char> block(std::min(count, ByteBlockSize));
+			out.reserve(out.size() + count);
+			while (count > 0 && ifs)
+			{
+				ifs.read(block.data(), std::min(count, block.size()));
+				size_t read = (size_t)ifs.gcount();
+				for (size_t i = 0; i < read; i++)
+					out.push_back((uint8_t)block[i]);
+				count -= read;
+			}
+		}
+	}
 
-		std::ifstream ifs;
-		ifs.open(path, std::ios::binary);
+	//read count bytes (or less at the end of the file) starting at start
+	template<typename T>
+	static std::vector<T> readFileBytes(Runtime& runtime, const std::string& path, std::streamoff start, std::streamoff count)
+	{
+		flushOutputFiles(runtime);
+		std::ifstream ifs(path, std::ios::binary | std::ios::ate);
 		if (!ifs.is_open()) throw runtime_error("Die Datei '" + path + "' konnte nicht geffnet werden!");
-		ifs.unsetf(std::ios::skipws);
 
-		ifs.seekg(0, std::ios::end);
-		std::streampos fileSize = ifs.tellg();
-		ifs.seekg(0, std::ios::beg);
+		std::vector<T> bytes;
+		std::streamoff fileSize = ifs.tellg();
+		if (start >= fileSize) return bytes; //nothing left to read
 
-		std::vector<uint8_t> file;
-		file.reserve(fileSize);
+		ifs.seekg(start, std::ios::beg);
+		readBytes(ifs, bytes, (size_t)std::min(count, fileSize - start));
+		return bytes;
+	}
 
-		file.insert(file.begin(), std::istream_iterator<uint8_t>(ifs), std::istream_iterator<uint8_t>());
+	//the start and count arguments of leseBytesBereich and leseBinaerBereich
+	static std::pair<std::streamoff, std::streamoff> getByteRange(std::vector<Value>& args)
+	{
+		//a Zahl only reaches 2 GB, so the start may also be a whole Kommazahl, which is exact up to 2^53
+		std::streamoff start;
+		if (args.at(1).type() == Type::Int)
+			start = args.at(1).Int();
+		else
+		{
+			double d = args.at(1).Double();
+			if (d != std::floor(d) || std::abs(d) > 9007199254740992.0)
+				throw runtime_error("Der Start des Bereichs der gelesen werden soll muss eine ganze Zahl sein!");
+			start = (std::streamoff)d;
+		}
+		int count = args.at(2).Int();
+		if (start < 0 || count < 0) throw runtime_error("Der Bereich der gelesen werden soll darf nicht negativ sein!");
+		return std::make_pair(start, (std::streamoff)count);
+	}
 
-		ifs.close();
+	//write the Zahlen or Bytes in bytes to ofs
+	static void writeBytes(std::ofstream& ofs, Value& bytes)
+	{
+		if (bytes.type() == Type::Bytes)
+		{
+			ofs.write((const char*)bytes.Bytes()->data(), bytes.Bytes()->size());
+			return;
+		}
+
+		const std::vector<int>& ints = *bytes.IntArr();
+		std::vector<char> block(std::min(ints.size(), ByteBlockSize));
+		for (size_t start = 0; start < ints.size(); start += block.size())
+		{
+			size_t n = std::min(block.size(), ints.size() - start);
+			for (size_t i = 0; i < n; i++)
+				block[i] = (char)(uint8_t)ints[start + i];
+			ofs.write(block.data(), n);
+		}
+	}
+
+	Value leseBytesNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return Value(readFileBytes<int>(runtime, *args.at(0).String(), 0, std::numeric_limits<std::streamoff>::max()));
+	}
+
+	Value leseBytesBereichNative(Runtime& runtime, std::vector<Value> args)
+	{
+		auto [start, count] = getByteRange(args);
+		return Value(readFileBytes<int>(runtime, *args.at(0).String(), start, count));
+	}
 
-		std::vector<int> ints;
-		ints.resize(file.size());
-		std::copy(file.begin(), file.end(), ints.begin());
+	Value leseBinaerNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return Value(readFileBytes<uint8_t>(runtime, *args.at(0).String(), 0, std::numeric_limits<std::streamoff>::max()));
+	}
 
-		return Value(ints);
+	Value leseBinaerBereichNative(Runtime& runtime, std::vector<Value> args)
+	{
+		auto [start, count] = getByteRange(args);
+		return Value(readFileBytes<uint8_t>(runtime, *args.at(0).String(), start, count));
 	}
 
-	Value schreibeBytesNative(std::vector<Value> args)
+	Value schreibeBytesNative(Runtime& runtime, std::vector<Value> args)
 	{
 		std::string path = *args.at(0).String();
 
+		closeOutputFile(runtime, path);
 		std::ofstream ofs(path, std::ios::binary);
 		if (!ofs.is_open()) throw runtime_error("Die Datei '" + path + "' konnte nicht geffnet werden!");
 
-		std::vector<int> ints = *args.at(1).IntArr();
-		for (auto& i : ints)
-			ofs << (uint8_t)i;
-
-		ofs.close();
+		writeBytes(ofs, args.at(1));
 
 		return Value();
 	}
 
-	Value bearbeiteBytesNative(std::vector<Value> args)
+	Value bearbeiteBytesNative(Runtime& runtime, std::vector<Value> args)
 	{
 		std::string path = *args.at(0).String();
 
 		if (!std::filesystem::exists(path)) throw runtime_error("Die Datie '" + path + "' existiert nicht und kann somit nicht bearbeitet werden!");
 
+		closeOutputFile(runtime, path);
 		std::ofstream ofs;
 		ofs.open(path, std::ofstream::app | std::ios::binary);
 		if (!ofs.is_open()) throw runtime_error("Die Datei '" + path + "' konnte nicht geffnet werden!");
 
-		std::vector<int> ints = *args.at(1).IntArr();
-		for (auto& i : ints)
-			ofs << (uint8_t)i;
+		writeBytes(ofs, args.at(1));
 
-		ofs.close();
+		return Value();
+	}
+
+	//runtime.readersLock has to be held while the reader is used
+	static LineReader& getLineReader(Runtime& runtime, int id)
+	{
+		auto it = runtime.lineReaders.find(id);
+		if (it == runtime.lineReaders.end()) throw runtime_error("Es gibt keinen offenen Zeilen Leser mit der Nummer " + std::to_string(id) + "!");
+		return *it->second;
+	}
+
+	Value oeffneZeilenLeserNative(Runtime& runtime, std::vector<Value> args)
+	{
+		std::string path = *args.at(0).String();
+
+		flushOutputFiles(runtime);
+		auto reader = std::make_unique<LineReader>(path);
+		if (!reader->isOpen()) throw runtime_error("Die Datei '" + path + "' konnte nicht geffnet werden!");
+
+		std::lock_guard<std::mutex> lock(runtime.readersLock);
+		int id = runtime.nextLineReader++;
+		runtime.lineReaders.emplace(id, std::move(reader));
+		return Value(id);
+	}
+
+	Value naechsteZeileNative(Runtime& runtime, std::vector<Value> args)
+	{
+		std::lock_guard<std::mutex> lock(runtime.readersLock);
+		std::string line;
+		if (!getLineReader(runtime, args.at(0).Int()).nextLine(line))
+			throw runtime_error("Der Zeilen Leser ist bereits am Ende der Datei!");
+		return Value(std::move(line));
+	}
+
+	Value istAmEndeNative(Runtime& runtime, std::vector<Value> args)
+	{
+		std::lock_guard<std::mutex> lock(runtime.readersLock);
+		return Value(getLineReader(runtime, args.at(0).Int()).atEnd());
+	}
 
+	Value schliesseZeilenLeserNative(Runtime& runtime, std::vector<Value> args)
+	{
+		std::lock_guard<std::mutex> lock(runtime.readersLock);
+		if (runtime.lineReaders.erase(args.at(0).Int()) == 0)
+			throw runtime_error("Es gibt keinen offenen Zeilen Leser mit der Nummer " + std::to_string(args.at(0).Int()) + "!");
 		return Value();
 	}
 
-	Value clockNative(std::vector<Value> args)
+	Value oeffneKanalNative(Runtime& runtime, std::vector<Value> args)
+	{
+		int capacity = args.at(0).Int();
+		if (capacity <= 0 || capacity > (1 << 24))
+			throw runtime_error("Ein Kanal kann nicht " + std::to_string(capacity) + u8" Werte fassen!");
+		return Value(runtime.channels.open((size_t)capacity));
+	}
+
+	Value sendeNative(Runtime& runtime, std::vector<Value> args)
+	{
+		Channel& channel = runtime.channels.get(args.at(0).Int());
+		if (channel.trySend(args.at(1))) return Value();
+
+		TaskPool::Blocking blocking(runtime.tasks); //the receiver might be a task that still waits for a thread
+		channel.send(args.at(1));
+		return Value();
+	}
+
+	Value schliesseKanalNative(Runtime& runtime, std::vector<Value> args)
+	{
+		runtime.channels.get(args.at(0).Int()).close();
+		return Value();
+	}
+
+	Value istKanalAmEndeNative(Runtime& runtime, std::vector<Value> args)
+	{
+		Channel& channel = runtime.channels.get(args.at(0).Int());
+		TaskPool::Blocking blocking(runtime.tasks);
+		return Value(channel.atEnd());
+	}
+
+	Value clockNative(Runtime& runtime, std::vector<Value> args)
 	{
 		return Value((double)clock() / (double)CLOCKS_PER_SEC);
 	}
 
-	Value warteNative(std::vector<Value> args)
+	Value warteNative(Runtime& runtime, std::vector<Value> args)
 	{
 		double seconds = args.at(0).Double();
 		std::this_thread::sleep_for(std::chrono::milliseconds((int)(seconds * 1000)));
 		return Value();
 	}
 
-	Value zuZahlNative(std::vector<Value> args)
+	Value zuZahlNative(Runtime& runtime, std::vector<Value> args)
 	{
-		try
+		switch (args.at(0).type())
 		{
-			switch (args.at(0).type())
-			{
-			case Type::Int: return args.at(0);
-			case Type::Double: return Value((int)args.at(0).Double());
-			case Type::Bool: return Value(args.at(0).Bool() ? 1 : 0);
-			case Type::Char: return Value((int)args.at(0).Char());
-			case Type::String: return Value(std::stoi(*args.at(0).String()));
-			}
+		case Type::Int: return args.at(0);
+		case Type::Double: return Value((int)args.at(0).Double());
+		case Type::Bool: return Value(args.at(0).Bool() ? 1 : 0);
+		case Type::Char: return Value((int)args.at(0).Char());
+		case Type::String:
+		{
+			int result;
+			if (!Value::ParseInt(*args.at(0).String(), result))
+				throw runtime_error("Diese Zeichenkette kann nicht in eine Zahl umgewandelt werden!");
+			return Value(result);
 		}
-		catch (std::exception&)
+		}
+		return Value();
+	}
+
+	Value zuKommazahlNative(Runtime& runtime, std::vector<Value> args)
+	{
+		switch (args.at(0).type())
 		{
-			throw runtime_error("Diese Zeichenkette kann nicht in eine Zahl umgewandelt werden!");
+		case Type::Int: return Value((double)args.at(0).Int());
+		case Type::Double: return args.at(0);
+		case Type::Bool: return Value(args.at(0).Bool() ? 1.0 : 0.0);
+		case Type::Char: return Value((double)args.at(0).Char());
+		case Type::String:
+		{
+			double result;
+			if (!Value::ParseDouble(*args.at(0).String(), result))
+				throw runtime_error("Diese Zeichenkette kann nicht in eine Kommazahl umgewandelt werden!");
+			return Value(result);
+		}
 		}
 		return Value();
 	}
 
-	Value zuKommazahlNative(std::vector<Value> args)
+	Value zuZahlenNative(Runtime& runtime, std::vector<Value> args)
 	{
-		try
+		if (args.at(0).type() == Type::Bytes)
 		{
-			switch (args.at(0).type())
-			{
-			case Type::Int: return Value((double)args.at(0).Int());
-			case Type::Double: return args.at(0);
-			case Type::Bool: return Value(args.at(0).Bool() ? 1.0 : 0.0);
-			case Type::Char: return Value((double)args.at(0).Char());
-			case Type::String:
-			{
-				std::string str = *args.at(0).String();
-				std::replace(str.begin(), str.end(), ',', '.');
-				return Value(std::stod(str));
-			}
-			}
+			std::vector<uint8_t>* bytes = args.at(0).Bytes();
+			return Value(std::vector<int>(bytes->begin(), bytes->end()));
 		}
-		catch (std::exception&)
+
+		std::vector<std::string>* texts = args.at(0).StringArr();
+		std::vector<int> result(texts->size());
+		for (size_t i = 0; i < texts->size(); i++)
 		{
-			throw runtime_error("Diese Zeichenkette kann nicht in eine Kommazahl umgewandelt werden!");
+			if (!Value::ParseInt((*texts)[i], result[i]))
+				throw runtime_error("Der Text an der Stelle " + std::to_string(i) + " kann nicht in eine Zahl umgewandelt werden!");
 		}
-		return Value();
+		return Value(std::move(result));
+	}
+
+	Value zuKommazahlenNative(Runtime& runtime, std::vector<Value> args)
+	{
+		if (args.at(0).type() == Type::Matrix)
+			return Value(args.at(0).VMatrix()->data);
+
+		std::vector<std::string>* texts = args.at(0).StringArr();
+		std::vector<double> result(texts->size());
+		for (size_t i = 0; i < texts->size(); i++)
+		{
+			if (!Value::ParseDouble((*texts)[i], result[i]))
+				throw runtime_error("Der Text an der Stelle " + std::to_string(i) + " kann nicht in eine Kommazahl umgewandelt werden!");
+		}
+		return Value(std::move(result));
+	}
+
+	Value zuBytesNative(Runtime& runtime, std::vector<Value> args)
+	{
+		std::vector<int>* ints = args.at(0).IntArr();
+		std::vector<uint8_t> bytes(ints->size());
+		for (size_t i = 0; i < ints->size(); i++)
+			bytes[i] = (uint8_t)(*ints)[i];
+		return Value(std::move(bytes));
 	}
 
-	Value zuBooleanNative(std::vector<Value> args)
+	Value zuBooleanNative(Runtime& runtime, std::vector<Value> args)
 	{
 		switch (args.at(0).type())
 		{
@@ -263,7 +563,7 @@ namespace Natives
 		return Value();
 	}
 
-	Value zuBuchstabeNative(std::vector<Value> args)
+	Value zuBuchstabeNative(Runtime& runtime, std::vector<Value> args)
 	{
 		switch (args.at(0).type())
 		{
@@ -284,14 +584,14 @@ namespace Natives
 		return Value();
 	}
 
-	Value zuTextNative(std::vector<Value> args)
+	Value zuTextNative(Runtime& runtime, std::vector<Value> args)
 	{
 		std::stringstream ss;
 		args.at(0).print(ss);
 		return Value(ss.str());
 	}
 
-	Value LaengeNative(std::vector<Value> args)
+	Value LaengeNative(Runtime& runtime, std::vector<Value> args)
 	{
 		switch (args.at(0).type())
 		{
@@ -301,85 +601,128 @@ namespace Natives
 		case Type::BoolArr: return Value((int)args.at(0).BoolArr()->size());
 		case Type::CharArr: return Value((int)args.at(0).CharArr()->size());
 		case Type::StringArr: return Value((int)args.at(0).StringArr()->size());
+		case Type::StructArr: return Value((int)args.at(0).StructArr()->size());
+		case Type::Bytes: return Value((int)args.at(0).Bytes()->size());
+		case Type::Dictionary: return Value((int)args.at(0).VDictionary()->size());
 		}
 		return Value(-1);
 	}
 
-	Value ZuschneidenNative(std::vector<Value> args)
+	//a Text or Buchstabe argument as text without copying a Text, buffer holds the utf8 of a Buchstabe
+	static std::string_view getTextArg(Value& arg, std::string& buffer)
+	{
+		if (arg.type() == Type::Char) return buffer = Value::U8CharToString(arg.Char());
+		return *arg.String();
+	}
+
+	//str.find(x, start), but a single char like ',' or '\n' is searched with memchr which is a lot faster
+	static size_t findText(std::string_view str, std::string_view x, size_t start)
 	{
-		std::string str = *args.at(0).String();
+		if (x.size() != 1) return str.find(x, start);
+		if (start >= str.size()) return std::string_view::npos;
+		const void* found = std::memchr(str.data() + start, x[0], str.size() - start);
+		return found == nullptr ? std::string_view::npos : (const char*)found - str.data();
+	}
+
+	Value ZuschneidenNative(Runtime& runtime, std::vector<Value> args)
+	{
+		std::string_view str = *args.at(0).String();
 		int start = args.at(1).Int();
 		int length = args.at(2).Int();
 
-		return Value(str.substr(start, length));
+		return Value(std::string(str.substr(start, length)));
 	}
 
-	Value SpaltenNative(std::vector<Value> args)
+	Value SpaltenNative(Runtime& runtime, std::vector<Value> args)
 	{
-		std::string str = *args.at(0).String();
-		std::string delimiter;
-		switch (args.at(1).type())
+		std::string_view str = *args.at(0).String();
+		std::string buffer;
+		std::string_view delimiter = getTextArg(args.at(1), buffer);
+
+		std::vector<std::string> tokens;
+		if (delimiter.empty())
 		{
-		case Type::Char: delimiter = Value::U8CharToString(args.at(1).Char()); break;
-		case Type::String: delimiter = *args.at(1).String(); break;
+			tokens.emplace_back(str);
+			return Value(std::move(tokens));
 		}
-		size_t pos = 0;
-		std::vector<std::string> tokens;
-		while ((pos = str.find(delimiter)) != std::string::npos)
+
+		size_t start = 0, pos;
+		while ((pos = findText(str, delimiter, start)) != std::string_view::npos)
 		{
-			tokens.push_back(str.substr(0, pos));
-			str.erase(0, pos + delimiter.length());
+			tokens.emplace_back(str.substr(start, pos - start));
+			start = pos + delimiter.size();
 		}
-		tokens.push_back(str);
+		tokens.emplace_back(str.substr(start));
 		return Value(std::move(tokens));
 	}
 
-	Value ErsetzenNative(std::vector<Value> args)
+	Value ErsetzenNative(Runtime& runtime, std::vector<Value> args)
 	{
-		std::string str = *args.at(0).String();
-		std::string from;
-		std::string to;
-		switch (args.at(1).type())
+		std::string fromBuffer, toBuffer;
+		std::string_view from = getTextArg(args.at(1), fromBuffer);
+		std::string_view to = getTextArg(args.at(2), toBuffer);
+
+		std::string_view str = *args.at(0).String();
+		size_t pos = from.empty() ? std::string_view::npos : findText(str, from, 0);
+		if (pos == std::string_view::npos)
+			return std::move(args.at(0));
+
+		//build the result in one pass instead of shifting the rest of the text on every replace
+		std::string result;
+		result.reserve(str.size());
+		size_t start = 0;
+		for (; pos != std::string_view::npos; pos = findText(str, from, start))
 		{
-		case Type::Char: from = Value::U8CharToString(args.at(1).Char()); break;
-		case Type::String: from = *args.at(1).String(); break;
-		}
-		switch (args.at(2).type())
-		{
-		case Type::Char: to = Value::U8CharToString(args.at(2).Char()); break;
-		case Type::String: to = *args.at(2).String(); break;
+			result.append(str, start, pos - start);
+			result.append(to);
+			start = pos + from.size();
 		}
+		result.append(str, start);
+		return Value(std::move(result));
+	}
 
-		if (from.empty())
-			return Value(str);
-		size_t start_pos = 0;
-		while ((start_pos = str.find(from, start_pos)) != std::string::npos)
-		{
-			str.replace(start_pos, from.length(), to);
-			start_pos += to.length();
-		}
-		
-		return Value(str);
+	template<typename T>
+	static void eraseElements(std::vector<T>& vec, int start, int length)
+	{
+		if (start < 0 || start > (int)vec.size())
+			throw runtime_error(u8"Es wurde versucht auf ein Array Element auerhalb der Reichweite zuzugreifen!");
+		size_t end = std::min(vec.size(), (size_t)start + std::max(length, 0));
+		vec.erase(vec.begin() + start, vec.begin() + end);
 	}
 
-	Value EntfernenNative(std::vector<Value> args)
+	Value EntfernenNative(Runtime& runtime, std::vector<Value> args)
 	{
-		std::string str = *args.at(0).String();
 		int start = args.at(1).Int();
 		int length = args.at(2).Int();
 
-		if (start + length > str.length())
-			str.erase(str.begin() + start, str.end());
-		else
-			str.erase(str.begin() + start, str.begin() + start + length);
-		return Value(str);
+		switch (args.at(0).type())
+		{
+		case Type::String:
+		{
+			std::string& str = *args.at(0).String();
+			if (start + length > str.length())
+				str.erase(str.begin() + start, str.end());
+			else
+				str.erase(str.begin() + start, str.begin() + start + length);
+			break;
+		}
+		//arrays are shared between copies, so this changes the array of the caller
+		case Type::IntArr: eraseElements(*args.at(0).IntArr(), start, length); break;
+		case Type::DoubleArr: eraseElements(*args.at(0).DoubleArr(), start, length); break;
+		case Type::BoolArr: eraseElements(*args.at(0).BoolArr(), start, length); break;
+		case Type::CharArr: eraseElements(*args.at(0).CharArr(), start, length); break;
+		case Type::StringArr: eraseElements(*args.at(0).StringArr(), start, length); break;
+		case Type::StructArr: eraseElements(*args.at(0).StructArr(), start, length); break;
+		case Type::Bytes: eraseElements(*args.at(0).Bytes(), start, length); break;
+		}
+		return std::move(args.at(0));
 	}
 
-	Value EinfgenNative(std::vector<Value> args)
+	Value EinfgenNative(Runtime& runtime, std::vector<Value> args)
 	{
-		std::string str = *args.at(0).String();
+		std::string& str = *args.at(0).String();
 		int pos = args.at(1).Int();
-		std::string in = *args.at(2).String();
+		const std::string& in = *args.at(2).String();
 
 		if (pos > (int)str.length())
 			str.insert(str.length(), in);
@@ -387,34 +730,66 @@ namespace Natives
 			str.insert(0, in);
 		else
 			str.insert(pos, in);
-		return Value(str);
+		return std::move(args.at(0));
 	}
 
-	Value EnthltNative(std::vector<Value> args)
+	template<typename T>
+	static void appendElements(std::vector<T>& vec, const std::vector<T>& other)
 	{
-		std::string str = *args.at(0).String();
-		std::string x;
-		switch (args.at(1).type())
+		if (&vec == &other) //'arr plus arr', insert must not read from the vector it grows
 		{
-		case Type::Char: x = Value::U8CharToString(args.at(1).Char()); break;
-		case Type::String: x = *args.at(1).String(); break;
+			std::vector<T> copy = other;
+			vec.insert(vec.end(), copy.begin(), copy.end());
 		}
-		return Value(str.find(x) != std::string::npos);
+		else
+			vec.insert(vec.end(), other.begin(), other.end());
 	}
 
-	Value BeschneidenNative(std::vector<Value> args)
+	void appendToArray(Value& arr, Value& x)
 	{
-		std::string s = *args.at(0).String();
-		s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char ch) {
-			return !std::isspace(ch);
-			}));
-		s.erase(std::find_if(s.rbegin(), s.rend(), [](unsigned char ch) {
-			return !std::isspace(ch);
-			}).base(), s.end());
-		return Value(s);
+		bool whole = x.type() == arr.type();
+		if (!whole && x.type() != elementType(arr.type()) && !(arr.type() == Type::DoubleArr && x.type() == Type::Int))
+			throw runtime_error(u8"Der Wert hat nicht den Typ der Elemente des Arrays!");
+
+		switch (arr.type())
+		{
+		case Type::IntArr: if (whole) appendElements(*arr.IntArr(), *x.IntArr()); else arr.IntArr()->push_back(x.Int()); break;
+		case Type::DoubleArr:
+			if (whole) appendElements(*arr.DoubleArr(), *x.DoubleArr());
+			else arr.DoubleArr()->push_back(x.type() == Type::Int ? (double)x.Int() : x.Double());
+			break;
+		case Type::BoolArr: if (whole) appendElements(*arr.BoolArr(), *x.BoolArr()); else arr.BoolArr()->push_back(x.Bool()); break;
+		case Type::CharArr: if (whole) appendElements(*arr.CharArr(), *x.CharArr()); else arr.CharArr()->push_back(x.Char()); break;
+		case Type::StringArr: if (whole) appendElements(*arr.StringArr(), *x.StringArr()); else arr.StringArr()->push_back(*x.String()); break;
+		case Type::StructArr: if (whole) appendElements(*arr.StructArr(), *x.StructArr()); else arr.StructArr()->push_back(*x.VStruct()); break;
+		case Type::Bytes: if (whole) appendElements(*arr.Bytes(), *x.Bytes()); else arr.Bytes()->push_back((uint8_t)x.Int()); break;
+		}
 	}
 
-	Value Max(std::vector<Value> args)
+	Value AnhaengenNative(Runtime& runtime, std::vector<Value> args)
+	{
+		appendToArray(args.at(0), args.at(1));
+		return std::move(args.at(0));
+	}
+
+	Value EnthltNative(Runtime& runtime, std::vector<Value> args)
+	{
+		std::string_view str = *args.at(0).String();
+		std::string buffer;
+		std::string_view x = getTextArg(args.at(1), buffer);
+		return Value(findText(str, x, 0) != std::string_view::npos);
+	}
+
+	Value BeschneidenNative(Runtime& runtime, std::vector<Value> args)
+	{
+		std::string_view s = *args.at(0).String();
+		auto notSpace = [](unsigned char ch) { return !std::isspace(ch); };
+		auto first = std::find_if(s.begin(), s.end(), notSpace);
+		auto last = std::find_if(s.rbegin(), std::make_reverse_iterator(first), notSpace).base();
+		return Value(std::string(first, last));
+	}
+
+	Value Max(Runtime& runtime, std::vector<Value> args)
 	{
 		switch (args.at(0).type())
 		{
@@ -438,7 +813,7 @@ namespace Natives
 		return Value();
 	}
 
-	Value Min(std::vector<Value> args)
+	Value Min(Runtime& runtime, std::vector<Value> args)
 	{
 		switch (args.at(0).type())
 		{
@@ -462,7 +837,7 @@ namespace Natives
 		return Value();
 	}
 
-	Value Clamp(std::vector<Value> args)
+	Value Clamp(Runtime& runtime, std::vector<Value> args)
 	{
 		switch (args.at(0).type())
 		{
@@ -514,46 +889,539 @@ namespace Natives
 		return Value();
 	}
 
-	Value Trunkiert(std::vector<Value> args)
+	Value Trunkiert(Runtime& runtime, std::vector<Value> args)
 	{
 		return Value(std::trunc(args.at(0).Double()));
 	}
 
-	Value Rund(std::vector<Value> args)
+	Value Rund(Runtime& runtime, std::vector<Value> args)
 	{
 		return Value(std::round(args.at(0).Double()));
 	}
 
-	Value Decke(std::vector<Value> args)
+	Value Decke(Runtime& runtime, std::vector<Value> args)
 	{
 		return Value(std::ceil(args.at(0).Double()));
 	}
 
-	Value Boden(std::vector<Value> args)
+	Value Boden(Runtime& runtime, std::vector<Value> args)
 	{
 		return Value(std::floor(args.at(0).Double()));
 	}
 
-	Value ZufaelligeZahlNative(std::vector<Value> args)
+	Value ZufaelligeZahlNative(Runtime& runtime, std::vector<Value> args)
+	{
+		std::lock_guard<std::mutex> lock(runtime.randomLock);
+		return Value(runtime.random.nextInt(args.at(0).Int(), args.at(1).Int()));
+	}
+
+	Value ZufaelligeKommazahlNative(Runtime& runtime, std::vector<Value> args)
 	{
-		int v1 = args.at(0).Int();
-		int v2 = args.at(1).Int();
+		std::lock_guard<std::mutex> lock(runtime.randomLock);
+		return Value(runtime.random.nextDouble(args.at(0).Double(), args.at(1).Double()));
+	}
+
+	static size_t getRandomCount(Value& count)
+	{
+		if (count.Int() < 0) throw runtime_error("Es knnen keine " + std::to_string(count.Int()) + " Zufallszahlen erzeugt werden!");
+		return (size_t)count.Int();
+	}
+
+	Value ZufaelligeZahlenNative(Runtime& runtime, std::vector<Value> args)
+	{
+		std::vector<int> numbers(getRandomCount(args.at(0)));
+		int min = args.at(1).Int();
+		int max = args.at(2).Int();
+		std::lock_guard<std::mutex> lock(runtime.randomLock);
+		for (int& number : numbers)
+			number = runtime.random.nextInt(min, max);
+		return Value(std::move(numbers));
+	}
+
+	Value ZufaelligeKommazahlenNative(Runtime& runtime, std::vector<Value> args)
+	{
+		std::vector<double> numbers(getRandomCount(args.at(0)));
+		double min = args.at(1).Double();
+		double max = args.at(2).Double();
+		std::lock_guard<std::mutex> lock(runtime.randomLock);
+		for (double& number : numbers)
+			number = runtime.random.nextDouble(min, max);
+		return Value(std::move(numbers));
+	}
+
+	static constexpr size_t ParallelThreshold = 1 << 15; //below this many elements starting the threads costs more than it saves
+
+	//true if an algorithm over count elements should use all threads
+	static bool runParallel(Runtime& runtime, size_t count)
+	{
+		//inside a parallel fr body the cores are already busy
+		return count >= ParallelThreshold && runtime.threads.size() > 1 && !ThreadPool::isWorker();
+	}
+
+	//sort one part per thread, then merge neighbouring parts until one is left
+	template<typename T>
+	static void parallelSort(Runtime& runtime, std::vector<T>& vec)
+	{
+		if (!runParallel(runtime, vec.size()))
+		{
+			std::sort(vec.begin(), vec.end());
+			return;
+		}
+
+		size_t parts = runtime.threads.size();
+		std::vector<size_t> bounds(parts + 1);
+		for (size_t i = 0; i <= parts; i++)
+			bounds[i] = vec.size() * i / parts;
+
+		runtime.threads.forEach((uint32_t)parts, [&](size_t worker, uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; i++)
+				std::sort(vec.begin() + bounds[i], vec.begin() + bounds[i + 1]);
+		});
+		for (size_t width = 1; width < parts; width *= 2)
+		{
+			uint32_t merges = (uint32_t)((parts + 2 * width - 1) / (2 * width));
+			runtime.threads.forEach(merges, [&](size_t worker, uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; i++)
+				{
+					size_t first = i * 2 * width;
+					size_t middle = std::min(first + width, parts);
+					size_t last = std::min(first + 2 * width, parts);
+					if (middle < last)
+						std::inplace_merge(vec.begin() + bounds[first], vec.begin() + bounds[middle], vec.begin() + bounds[last]);
+				}
+			});
+		}
+	}
+
+	//combine(init, range(begin, end)) over parts of [0, count), on all threads for big counts
+	template<typename Result, typename Range, typename Combine>
+	static Result reduce(Runtime& runtime, size_t count, Result init, Range range, Combine combine)
+	{
+		if (!runParallel(runtime, count)) return combine(init, range(0, count));
+
+		std::vector<Result> partial(runtime.threads.size(), init);
+		runtime.threads.forEach((uint32_t)count, [&](size_t worker, uint32_t begin, uint32_t end)
+		{
+			partial[worker] = combine(partial[worker], range(begin, end));
+		});
+		Result result = init;
+		for (const Result& part : partial)
+			result = combine(result, part);
+		return result;
+	}
+
+	static constexpr size_t NotFound = SIZE_MAX;
+
+	//index of the smallest (or with Greater the biggest) element, the first one if there are several
+	template<typename T, typename Compare>
+	static size_t findExtreme(Runtime& runtime, const std::vector<T>& vec, Compare better)
+	{
+		if (vec.empty()) throw runtime_error(u8"Ein leeres Array hat kein Minimum und kein Maximum!");
+		auto pick = [&](size_t a, size_t b)
+		{
+			if (a == NotFound) return b;
+			if (b == NotFound) return a;
+			if (better(vec[b], vec[a]) || (!better(vec[a], vec[b]) && b < a)) return b;
+			return a;
+		};
+		return reduce(runtime, vec.size(), NotFound, [&](size_t begin, size_t end)
+		{
+			return (size_t)(std::min_element(vec.begin() + begin, vec.begin() + end, better) - vec.begin());
+		}, pick);
+	}
+
+	//index of the first element equal to x
+	template<typename T>
+	static size_t findFirst(Runtime& runtime, const std::vector<T>& vec, const T& x)
+	{
+		std::atomic<size_t> first(NotFound); //parts behind an element that was already found are skipped
+		return reduce(runtime, vec.size(), NotFound, [&](size_t begin, size_t end)
+		{
+			if (begin > first.load(std::memory_order_relaxed)) return NotFound;
+			size_t index = (size_t)(std::find(vec.begin() + begin, vec.begin() + end, x) - vec.begin());
+			if (index == end) return NotFound;
+			size_t old = first.load(std::memory_order_relaxed);
+			while (index < old && !first.compare_exchange_weak(old, index, std::memory_order_relaxed));
+			return index;
+		}, [](size_t a, size_t b) { return std::min(a, b); });
+	}
+
+	template<typename T>
+	static size_t binarySearch(const std::vector<T>& vec, const T& x)
+	{
+		auto it = std::lower_bound(vec.begin(), vec.end(), x);
+		if (it == vec.end() || *it != x) return NotFound;
+		return (size_t)(it - vec.begin());
+	}
+
+	static Value indexToValue(size_t index)
+	{
+		return Value(index == NotFound ? -1 : (int)index);
+	}
+
+	//Finde and BinaerSuche with the matching overload of search
+	template<typename Search>
+	static Value searchArray(std::vector<Value>& args, Search search)
+	{
+		Value& arr = args.at(0);
+		Value& x = args.at(1);
+		switch (arr.type())
+		{
+		case Type::IntArr:
+			if (x.type() != Type::Int) break;
+			return indexToValue(search(*arr.IntArr(), x.Int()));
+		case Type::DoubleArr:
+			if (x.type() == Type::Int) return indexToValue(search(*arr.DoubleArr(), (double)x.Int()));
+			if (x.type() != Type::Double) break;
+			return indexToValue(search(*arr.DoubleArr(), x.Double()));
+		case Type::StringArr:
+			if (x.type() != Type::String) break;
+			return indexToValue(search(*arr.StringArr(), *x.String()));
+		}
+		throw runtime_error(u8"Der gesuchte Wert hat nicht den Typ der Elemente des Arrays!");
+	}
+
+	Value SortiereNative(Runtime& runtime, std::vector<Value> args)
+	{
+		//arrays are shared between copies, so the argument itself is left as it is
+		switch (args.at(0).type())
+		{
+		case Type::IntArr:
+		{
+			std::vector<int> vec = *args.at(0).IntArr();
+			parallelSort(runtime, vec);
+			return Value(std::move(vec));
+		}
+		case Type::DoubleArr:
+		{
+			std::vector<double> vec = *args.at(0).DoubleArr();
+			parallelSort(runtime, vec);
+			return Value(std::move(vec));
+		}
+		case Type::StringArr:
+		{
+			std::vector<std::string> vec = *args.at(0).StringArr();
+			parallelSort(runtime, vec);
+			return Value(std::move(vec));
+		}
+		}
+		throw runtime_error(u8"Sortiere kann nur Zahlen, Kommazahlen und Texte sortieren!");
+	}
+
+	Value SummeNative(Runtime& runtime, std::vector<Value> args)
+	{
+		if (args.at(0).type() == Type::DoubleArr)
+		{
+			const std::vector<double>& vec = *args.at(0).DoubleArr();
+			return Value(reduce(runtime, vec.size(), 0.0, [&](size_t begin, size_t end)
+			{
+				return std::accumulate(vec.begin() + begin, vec.begin() + end, 0.0);
+			}, std::plus<double>()));
+		}
+
+		const std::vector<int>& vec = *args.at(0).IntArr();
+		int64_t sum = reduce(runtime, vec.size(), (int64_t)0, [&](size_t begin, size_t end)
+		{
+			return std::accumulate(vec.begin() + begin, vec.begin() + end, (int64_t)0);
+		}, std::plus<int64_t>());
+		if (sum < INT_MIN || sum > INT_MAX)
+			throw runtime_error(u8"Die Summe ist zu gro fr eine Zahl!");
+		return Value((int)sum);
+	}
+
+	//Minimum and Maximum with better deciding which of two elements is kept
+	template<template<typename> typename Better>
+	static Value extremeElement(Runtime& runtime, Value& arr)
+	{
+		switch (arr.type())
+		{
+		case Type::IntArr: return Value(arr.IntArr()->at(findExtreme(runtime, *arr.IntArr(), Better<int>())));
+		case Type::DoubleArr: return Value(arr.DoubleArr()->at(findExtreme(runtime, *arr.DoubleArr(), Better<double>())));
+		case Type::StringArr: return Value(arr.StringArr()->at(findExtreme(runtime, *arr.StringArr(), Better<std::string>())));
+		}
+		throw runtime_error(u8"Minimum und Maximum gibt es nur fr Zahlen, Kommazahlen und Texte!");
+	}
+
+	Value MinimumNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return extremeElement<std::less>(runtime, args.at(0));
+	}
+
+	Value MaximumNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return extremeElement<std::greater>(runtime, args.at(0));
+	}
+
+	Value FindeNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return searchArray(args, [&](const auto& vec, const auto& x) { return findFirst(runtime, vec, x); });
+	}
+
+	Value BinaerSucheNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return searchArray(args, [](const auto& vec, const auto& x) { return binarySearch(vec, x); });
+	}
+
+	//kernel(begin, end) over parts of [0, count), on all threads for big counts
+	template<typename Kernel>
+	static void forParts(Runtime& runtime, size_t count, Kernel kernel)
+	{
+		if (!runParallel(runtime, count))
+		{
+			kernel((size_t)0, count);
+			return;
+		}
+		runtime.threads.forEach((uint32_t)count, [&](size_t worker, uint32_t begin, uint32_t end)
+		{
+			kernel((size_t)begin, (size_t)end);
+		});
+	}
+
+	static void checkSameLength(const std::vector<double>& a, const std::vector<double>& b)
+	{
+		if (a.size() != b.size())
+			throw runtime_error(u8"Die Arrays mssen gleich lang sein!");
+	}
+
+	static double toDouble(Value& value)
+	{
+		return value.type() == Type::Int ? (double)value.Int() : value.Double();
+	}
+
+	//a new array with f applied to every element of vec
+	template<typename F>
+	static Value mapDoubles(Runtime& runtime, const std::vector<double>& vec, F f)
+	{
+		std::vector<double> result(vec.size());
+		forParts(runtime, vec.size(), [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+				result[i] = f(vec[i]);
+		});
+		return Value(std::move(result));
+	}
+
+	Value AddiereNative(Runtime& runtime, std::vector<Value> args)
+	{
+		const std::vector<double>& a = *args.at(0).DoubleArr();
+		const std::vector<double>& b = *args.at(1).DoubleArr();
+		checkSameLength(a, b);
+		std::vector<double> result(a.size());
+		forParts(runtime, a.size(), [&](size_t begin, size_t end)
+		{
+			VectorMath::add(a.data() + begin, b.data() + begin, result.data() + begin, end - begin);
+		});
+		return Value(std::move(result));
+	}
+
+	Value MultipliziereNative(Runtime& runtime, std::vector<Value> args)
+	{
+		const std::vector<double>& a = *args.at(0).DoubleArr();
+		const std::vector<double>& b = *args.at(1).DoubleArr();
+		checkSameLength(a, b);
+		std::vector<double> result(a.size());
+		forParts(runtime, a.size(), [&](size_t begin, size_t end)
+		{
+			VectorMath::multiply(a.data() + begin, b.data() + begin, result.data() + begin, end - begin);
+		});
+		return Value(std::move(result));
+	}
+
+	Value SkaliereNative(Runtime& runtime, std::vector<Value> args)
+	{
+		const std::vector<double>& a = *args.at(0).DoubleArr();
+		double factor = toDouble(args.at(1));
+		std::vector<double> result(a.size());
+		forParts(runtime, a.size(), [&](size_t begin, size_t end)
+		{
+			VectorMath::scale(a.data() + begin, factor, result.data() + begin, end - begin);
+		});
+		return Value(std::move(result));
+	}
+
+	Value SkaliereAddiereNative(Runtime& runtime, std::vector<Value> args)
+	{
+		double alpha = toDouble(args.at(0));
+		const std::vector<double>& x = *args.at(1).DoubleArr();
+		const std::vector<double>& y = *args.at(2).DoubleArr();
+		checkSameLength(x, y);
+		std::vector<double> result(x.size());
+		forParts(runtime, x.size(), [&](size_t begin, size_t end)
+		{
+			VectorMath::axpy(alpha, x.data() + begin, y.data() + begin, result.data() + begin, end - begin);
+		});
+		return Value(std::move(result));
+	}
+
+	Value SkalarproduktNative(Runtime& runtime, std::vector<Value> args)
+	{
+		const std::vector<double>& a = *args.at(0).DoubleArr();
+		const std::vector<double>& b = *args.at(1).DoubleArr();
+		checkSameLength(a, b);
+		return Value(reduce(runtime, a.size(), 0.0, [&](size_t begin, size_t end)
+		{
+			return VectorMath::dot(a.data() + begin, b.data() + begin, end - begin);
+		}, std::plus<double>()));
+	}
+
+	//the C library is used for these, so every element is exactly what 'Sinus von' etc. give for it
+	Value SinuswerteNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return mapDoubles(runtime, *args.at(0).DoubleArr(), [](double x) { return std::sin(x); });
+	}
+
+	Value KosinuswerteNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return mapDoubles(runtime, *args.at(0).DoubleArr(), [](double x) { return std::cos(x); });
+	}
+
+	Value ExponentialwerteNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return mapDoubles(runtime, *args.at(0).DoubleArr(), [](double x) { return std::exp(x); });
+	}
+
+	Value LogarithmenNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return mapDoubles(runtime, *args.at(0).DoubleArr(), [](double x) { return std::log(x); });
+	}
 
-		std::random_device dev;
-		std::mt19937 rng(dev());
-		std::uniform_int_distribution uni(v1, v2);
-		return Value(uni(rng));
+	static Value::Matrix makeMatrix(int rows, int cols)
+	{
+		if (rows < 0 || cols < 0)
+			throw runtime_error(u8"Eine Matrix kann keine negative Anzahl an Zeilen oder Spalten haben!");
+		return Value::Matrix{ rows, cols, std::vector<double>((size_t)rows * cols, 0.0) };
+	}
+
+	Value NeueMatrixNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return Value(makeMatrix(args.at(0).Int(), args.at(1).Int()));
+	}
+
+	Value EinheitsmatrixNative(Runtime& runtime, std::vector<Value> args)
+	{
+		int n = args.at(0).Int();
+		Value::Matrix matrix = makeMatrix(n, n);
+		for (int i = 0; i < n; i++)
+			matrix.data[(size_t)i * n + i] = 1.0;
+		return Value(std::move(matrix));
+	}
+
+	Value zuMatrixNative(Runtime& runtime, std::vector<Value> args)
+	{
+		std::vector<double>& elements = *args.at(0).DoubleArr();
+		int cols = args.at(1).Int();
+		if (cols <= 0 || elements.size() % cols != 0)
+			throw runtime_error(u8"Die Anzahl der Kommazahlen muss ein Vielfaches der Anzahl der Spalten sein!");
+		return Value(Value::Matrix{ (int)(elements.size() / cols), cols, elements });
+	}
+
+	Value ZeilenanzahlNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return Value(args.at(0).VMatrix()->rows);
+	}
+
+	Value SpaltenanzahlNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return Value(args.at(0).VMatrix()->cols);
+	}
+
+	Value ZeileNative(Runtime& runtime, std::vector<Value> args)
+	{
+		const Value::Matrix& matrix = *args.at(0).VMatrix();
+		int row = args.at(1).Int();
+		if (row < 0 || row >= matrix.rows)
+			throw runtime_error("Die Matrix hat keine Zeile " + std::to_string(row) + "!");
+		auto begin = matrix.data.begin() + (size_t)row * matrix.cols;
+		return Value(std::vector<double>(begin, begin + matrix.cols));
+	}
+
+	Value SpalteNative(Runtime& runtime, std::vector<Value> args)
+	{
+		const Value::Matrix& matrix = *args.at(0).VMatrix();
+		int col = args.at(1).Int();
+		if (col < 0 || col >= matrix.cols)
+			throw runtime_error("Die Matrix hat keine Spalte " + std::to_string(col) + "!");
+		std::vector<double> column(matrix.rows);
+		for (int row = 0; row < matrix.rows; row++)
+			column[row] = matrix.data[(size_t)row * matrix.cols + col];
+		return Value(std::move(column));
+	}
+
+	static constexpr int TransposeBlock = 32; //a block of the source and one of the result fit into the L1 cache together
+
+	Value TransponiereNative(Runtime& runtime, std::vector<Value> args)
+	{
+		const Value::Matrix& matrix = *args.at(0).VMatrix();
+		Value::Matrix result = makeMatrix(matrix.cols, matrix.rows);
+		//going block by block, the column-wise writes hit cache lines that were just loaded instead of a new one each
+		for (int rowBlock = 0; rowBlock < matrix.rows; rowBlock += TransposeBlock)
+		{
+			int rowEnd = std::min(rowBlock + TransposeBlock, matrix.rows);
+			for (int colBlock = 0; colBlock < matrix.cols; colBlock += TransposeBlock)
+			{
+				int colEnd = std::min(colBlock + TransposeBlock, matrix.cols);
+				for (int row = rowBlock; row < rowEnd; row++)
+					for (int col = colBlock; col < colEnd; col++)
+						result.data[(size_t)col * matrix.rows + row] = matrix.data[(size_t)row * matrix.cols + col];
+			}
+		}
+		return Value(std::move(result));
 	}
 
-	Value ZufaelligeKommazahlNative(std::vector<Value> args)
+	//the part of the inner dimension and of the columns of b one block of the product works on.
+	//KBlock rows of ColBlock columns of b are 128 KB and stay in the L2 cache while every row of a passes over them
+	static constexpr int KBlock = 64;
+	static constexpr int ColBlock = 256;
+
+	//rows [rowBegin, rowEnd) of result = a * b, result has to be zeroed
+	static void multiplyRows(const Value::Matrix& a, const Value::Matrix& b, Value::Matrix& result, size_t rowBegin, size_t rowEnd)
 	{
-		double v1 = args.at(0).Double();
-		double v2 = args.at(1).Double();
+		for (int kBlock = 0; kBlock < a.cols; kBlock += KBlock)
+		{
+			int kEnd = std::min(kBlock + KBlock, a.cols);
+			for (int colBlock = 0; colBlock < b.cols; colBlock += ColBlock)
+			{
+				size_t width = (size_t)(std::min(colBlock + ColBlock, b.cols) - colBlock);
+				for (size_t row = rowBegin; row < rowEnd; row++)
+				{
+					double* out = result.data.data() + row * b.cols + colBlock;
+					for (int k = kBlock; k < kEnd; k++)
+					{
+						//one row of b scaled by a(row, k) is added to the row of the result
+						const double* bRow = b.data.data() + (size_t)k * b.cols + colBlock;
+						VectorMath::axpy(a.data[row * a.cols + k], bRow, out, out, width);
+					}
+				}
+			}
+		}
+	}
 
-		std::random_device dev;
-		std::mt19937 rng(dev());
-		std::uniform_real_distribution<double> uni(v1, v2);
-		return Value(uni(rng));
+	Value MatrixproduktNative(Runtime& runtime, std::vector<Value> args)
+	{
+		const Value::Matrix& a = *args.at(0).VMatrix();
+		const Value::Matrix& b = *args.at(1).VMatrix();
+		if (a.cols != b.rows)
+			throw runtime_error(u8"Die Anzahl der Spalten der ersten Matrix muss der Anzahl der Zeilen der zweiten entsprechen!");
+
+		Value::Matrix result = makeMatrix(a.rows, b.cols);
+		if (!runParallel(runtime, (size_t)a.rows * a.cols * b.cols))
+			multiplyRows(a, b, result, 0, a.rows);
+		else
+		{
+			//every thread computes its own rows of the result
+			runtime.threads.forEach((uint32_t)a.rows, [&](size_t worker, uint32_t begin, uint32_t end)
+			{
+				multiplyRows(a, b, result, begin, end);
+			});
+		}
+		return Value(std::move(result));
+	}
+
+	Value NeuesWoerterbuchNative(Runtime& runtime, std::vector<Value> args)
+	{
+		return Value(::Dictionary()); //the enum value Natives::Dictionary hides the class
 	}
 
 }
\ No newline at end of file
@@ -1,6 +1,16 @@
 #pragma once
 
 #include "Value.h"
+#include "OutputBuffer.h"
+#include "LineReader.h"
+#include "OutputFileCache.h"
+#include "Random.h"
+#include "ThreadPool.h"
+#include "TaskPool.h"
+#include "Channel.h"
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 class runtime_error : public std::exception
 {
@@ -12,68 +22,162 @@ namespace Natives
 {
 	enum CombineableValueType
 	{
-		None		= 0b00000000000001,
-		Int			= 0b00000000000010,
-		Double		= 0b00000000000100,
-		Bool		= 0b00000000001000,
-		Char		= 0b00000000010000,
-		String		= 0b00000000100000,
-		Struct		= 0b00000001000000,
-		IntArr		= 0b00000010000000,
-		DoubleArr	= 0b00000100000000,
-		BoolArr		= 0b00001000000000,
-		CharArr		= 0b00010000000000,
-		StringArr	= 0b00100000000000,
-		StructArr	= 0b01000000000000,
-		Any			= 0b10000000000000
+		None		= 0b00000000000000001,
+		Int			= 0b00000000000000010,
+		Double		= 0b00000000000000100,
+		Bool		= 0b00000000000001000,
+		Char		= 0b00000000000010000,
+		String		= 0b00000000000100000,
+		Struct		= 0b00000000001000000,
+		IntArr		= 0b00000000010000000,
+		DoubleArr	= 0b00000000100000000,
+		BoolArr		= 0b00000001000000000,
+		CharArr		= 0b00000010000000000,
+		StringArr	= 0b00000100000000000,
+		StructArr	= 0b00001000000000000,
+		Bytes		= 0b00010000000000000,
+		Matrix		= 0b00100000000000000,
+		Dictionary	= 0b01000000000000000,
+		Any			= 0b10000000000000000
 	};
 
 	bool ContainsType(CombineableValueType toCheck, ValueType type);
 
-	Value schreibeNative(std::vector<Value> args);
-	Value schreibeZeileNative(std::vector<Value> args);
-	Value leseNative(std::vector<Value> args);
-	Value leseZeileNative(std::vector<Value> args);
+	//state the natives keep between calls, owned by the VirtualMachine
+	struct Runtime
+	{
+		Runtime(OutputBuffer::FlushPolicy flushPolicy, uint64_t seed);
+
+		OutputBuffer out; //stdout, everything the program prints goes through here
+		LineReader in; //stdin, everything the program reads from the console goes through here
+		OutputFileCache outputFiles; //the files bearbeiteDatei keeps open
+		std::unordered_map<int, std::unique_ptr<LineReader>> lineReaders; //the open line readers mapped to the number the program knows them by
+		int nextLineReader = 1; //number of the next line reader that is opened
+		Random random; //used by all the Zufaellig... natives
+		ThreadPool threads; //runs parallel fr loops
+
+		//natives run on several threads at once in tasks and parallel fr loops, so every part of the state above has its own lock
+		std::mutex outLock; //out
+		std::mutex inLock; //in, always taken before outLock
+		std::mutex filesLock; //outputFiles
+		std::mutex readersLock; //lineReaders and nextLineReader
+		std::mutex randomLock; //random
+		std::shared_mutex globalsLock; //the global variables of the program, only used once a task was started
+
+		ChannelTable channels; //the channels tasks send values through, they need no lock
+
+		TaskPool tasks; //runs the tasks started with 'starte'. Declared last, so the tasks finish before the state they use is destroyed
+	};
+
+	Value schreibeNative(Runtime& runtime, std::vector<Value> args);
+	Value schreibeZeileNative(Runtime& runtime, std::vector<Value> args);
+	Value leseNative(Runtime& runtime, std::vector<Value> args);
+	Value leseZeileNative(Runtime& runtime, std::vector<Value> args);
+	Value leerePufferNative(Runtime& runtime, std::vector<Value> args);
+
+	//reading big inputs from stdin in one call
+	Value leseAlleZeilenNative(Runtime& runtime, std::vector<Value> args);
+	Value leseZeilenNative(Runtime& runtime, std::vector<Value> args); //the next n lines, less if the input ends before
+	Value leseAlleZahlenNative(Runtime& runtime, std::vector<Value> args); //all whitespace seperated numbers
+	Value leseAlleKommazahlenNative(Runtime& runtime, std::vector<Value> args);
 
-	Value existiertDateiNative(std::vector<Value> args);
-	Value leseDateiNative(std::vector<Value> args);
-	Value schreibeDateiNative(std::vector<Value> args);
-	Value bearbeiteDateiNative(std::vector<Value> args);
-	Value leseBytesNative(std::vector<Value> args);
-	Value schreibeBytesNative(std::vector<Value> args);
-	Value bearbeiteBytesNative(std::vector<Value> args);
+	Value existiertDateiNative(Runtime& runtime, std::vector<Value> args);
+	Value leseDateiNative(Runtime& runtime, std::vector<Value> args);
+	Value schreibeDateiNative(Runtime& runtime, std::vector<Value> args);
+	Value bearbeiteDateiNative(Runtime& runtime, std::vector<Value> args);
+	Value schliesseDateiNative(Runtime& runtime, std::vector<Value> args); //write everything bearbeiteDatei appended to a file and close it
+	Value leseBytesNative(Runtime& runtime, std::vector<Value> args);
+	Value leseBytesBereichNative(Runtime& runtime, std::vector<Value> args); //read only a part of a file, so huge files can be processed in chunks. The start may be a whole Kommazahl to reach past 2 GB
+	Value leseBinaerNative(Runtime& runtime, std::vector<Value> args); //like leseBytes but returns Bytes
+	Value leseBinaerBereichNative(Runtime& runtime, std::vector<Value> args); //like leseBytesBereich but returns Bytes, also past 2 GB
+	Value schreibeBytesNative(Runtime& runtime, std::vector<Value> args);
+	Value bearbeiteBytesNative(Runtime& runtime, std::vector<Value> args);
 
-	Value clockNative(std::vector<Value> args);
-	Value warteNative(std::vector<Value> args);
+	//reading big files line by line
+	Value oeffneZeilenLeserNative(Runtime& runtime, std::vector<Value> args);
+	Value naechsteZeileNative(Runtime& runtime, std::vector<Value> args);
+	Value istAmEndeNative(Runtime& runtime, std::vector<Value> args);
+	Value schliesseZeilenLeserNative(Runtime& runtime, std::vector<Value> args);
+
+	//channels between tasks, values are received with 'empfange <Kanal> als <Typ>'
+	Value oeffneKanalNative(Runtime& runtime, std::vector<Value> args); //a new channel that holds up to n values
+	Value sendeNative(Runtime& runtime, std::vector<Value> args); //waits while the channel is full
+	Value schliesseKanalNative(Runtime& runtime, std::vector<Value> args);
+	Value istKanalAmEndeNative(Runtime& runtime, std::vector<Value> args); //waits until the channel has a value or is closed, wahr if it is closed and empty
+
+	Value clockNative(Runtime& runtime, std::vector<Value> args);
+	Value warteNative(Runtime& runtime, std::vector<Value> args);
 
 	//casts
-	Value zuZahlNative(std::vector<Value> args);
-	Value zuKommazahlNative(std::vector<Value> args);
-	Value zuBooleanNative(std::vector<Value> args);
-	Value zuBuchstabeNative(std::vector<Value> args);
-	Value zuTextNative(std::vector<Value> args);
+	Value zuZahlNative(Runtime& runtime, std::vector<Value> args);
+	Value zuKommazahlNative(Runtime& runtime, std::vector<Value> args);
+	Value zuBooleanNative(Runtime& runtime, std::vector<Value> args);
+	Value zuBuchstabeNative(Runtime& runtime, std::vector<Value> args);
+	Value zuTextNative(Runtime& runtime, std::vector<Value> args);
+	Value zuZahlenNative(Runtime& runtime, std::vector<Value> args); //Texte or Bytes to Zahlen in one call
+	Value zuKommazahlenNative(Runtime& runtime, std::vector<Value> args); //Texte to Kommazahlen in one call, a Matrix to its elements row after row
+	Value zuBytesNative(Runtime& runtime, std::vector<Value> args);
 
-	Value LaengeNative(std::vector<Value> args);
+	Value LaengeNative(Runtime& runtime, std::vector<Value> args);
 
 	//string manipulation (Laenge could be counted too)
-	Value ZuschneidenNative(std::vector<Value> args);
-	Value SpaltenNative(std::vector<Value> args);
-	Value ErsetzenNative(std::vector<Value> args);
-	Value EntfernenNative(std::vector<Value> args);
-	Value EinfgenNative(std::vector<Value> args);
-	Value EnthltNative(std::vector<Value> args);
-	Value BeschneidenNative(std::vector<Value> args);
+	Value ZuschneidenNative(Runtime& runtime, std::vector<Value> args);
+	Value SpaltenNative(Runtime& runtime, std::vector<Value> args);
+	Value ErsetzenNative(Runtime& runtime, std::vector<Value> args);
+	Value EntfernenNative(Runtime& runtime, std::vector<Value> args); //also removes elements of an array, in place
+	Value EinfgenNative(Runtime& runtime, std::vector<Value> args);
+	Value EnthltNative(Runtime& runtime, std::vector<Value> args);
+	Value BeschneidenNative(Runtime& runtime, std::vector<Value> args);
+
+	//growing arrays in place, std::vector keeps spare capacity so appending is amortized O(1)
+	void appendToArray(Value& arr, Value& x); //append x, an element or an array of the same type. Also runs 'arr sind arr plus x'
+	Value AnhaengenNative(Runtime& runtime, std::vector<Value> args); //appends to the array and returns it
 
 	//math stuff
-	Value Max(std::vector<Value> args);
-	Value Min(std::vector<Value> args);
-	Value Clamp(std::vector<Value> args);
-	Value Trunkiert(std::vector<Value> args);
-	Value Rund(std::vector<Value> args);
-	Value Decke(std::vector<Value> args);
-	Value Boden(std::vector<Value> args);
-
-	Value ZufaelligeZahlNative(std::vector<Value> args);
-	Value ZufaelligeKommazahlNative(std::vector<Value> args);
+	Value Max(Runtime& runtime, std::vector<Value> args);
+	Value Min(Runtime& runtime, std::vector<Value> args);
+	Value Clamp(Runtime& runtime, std::vector<Value> args);
+	Value Trunkiert(Runtime& runtime, std::vector<Value> args);
+	Value Rund(Runtime& runtime, std::vector<Value> args);
+	Value Decke(Runtime& runtime, std::vector<Value> args);
+	Value Boden(Runtime& runtime, std::vector<Value> args);
+
+	Value ZufaelligeZahlNative(Runtime& runtime, std::vector<Value> args);
+	Value ZufaelligeKommazahlNative(Runtime& runtime, std::vector<Value> args);
+	Value ZufaelligeZahlenNative(Runtime& runtime, std::vector<Value> args); //n random numbers in one call
+	Value ZufaelligeKommazahlenNative(Runtime& runtime, std::vector<Value> args);
+
+	//algorithms over Zahlen, Kommazahlen and Texte, big arrays are processed on all cores
+	Value SortiereNative(Runtime& runtime, std::vector<Value> args); //a sorted copy of the array
+	Value SummeNative(Runtime& runtime, std::vector<Value> args);
+	Value MinimumNative(Runtime& runtime, std::vector<Value> args);
+	Value MaximumNative(Runtime& runtime, std::vector<Value> args);
+	Value FindeNative(Runtime& runtime, std::vector<Value> args); //index of the first element equal to the value, -1 if there is none
+	Value BinaerSucheNative(Runtime& runtime, std::vector<Value> args); //like Finde, but for sorted arrays
+
+	//element-wise math over Kommazahlen, see VectorMath. They return new arrays
+	Value AddiereNative(Runtime& runtime, std::vector<Value> args);
+	Value MultipliziereNative(Runtime& runtime, std::vector<Value> args);
+	Value SkaliereNative(Runtime& runtime, std::vector<Value> args);
+	Value SkaliereAddiereNative(Runtime& runtime, std::vector<Value> args); //alpha * x + y
+	Value SkalarproduktNative(Runtime& runtime, std::vector<Value> args);
+	Value SinuswerteNative(Runtime& runtime, std::vector<Value> args);
+	Value KosinuswerteNative(Runtime& runtime, std::vector<Value> args);
+	Value ExponentialwerteNative(Runtime& runtime, std::vector<Value> args);
+	Value LogarithmenNative(Runtime& runtime, std::vector<Value> args);
+
+	//Matrix
+	Value NeueMatrixNative(Runtime& runtime, std::vector<Value> args); //a matrix of zeros with the given rows and columns
+	Value EinheitsmatrixNative(Runtime& runtime, std::vector<Value> args);
+	Value zuMatrixNative(Runtime& runtime, std::vector<Value> args); //Kommazahlen row after row and the number of columns
+	Value ZeilenanzahlNative(Runtime& runtime, std::vector<Value> args);
+	Value SpaltenanzahlNative(Runtime& runtime, std::vector<Value> args);
+	Value ZeileNative(Runtime& runtime, std::vector<Value> args); //a row as Kommazahlen
+	Value SpalteNative(Runtime& runtime, std::vector<Value> args); //a column as Kommazahlen
+	Value TransponiereNative(Runtime& runtime, std::vector<Value> args);
+	Value MatrixproduktNative(Runtime& runtime, std::vector<Value> args);
+
+	//Wrterbuch
+	Value NeuesWoerterbuchNative(Runtime& runtime, std::vector<Value> args); //an empty Wrterbuch
 
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "OutputBuffer.h"
+
+OutputBuffer::OutputBuffer(std::FILE* file, FlushPolicy policy)
+	:
+	file(file),
+	policy(policy)
+{
+	buffer.reserve(BlockSize);
+}
+
+OutputBuffer::~OutputBuffer()
+{
+	flush();
+}
+
+void OutputBuffer::write(std::string_view str)
+{
+	buffer.append(str);
+	switch (policy)
+	{
+	case FlushPolicy::Line: if (str.find('\n') != std::string_view::npos) flush(); break;
+	case FlushPolicy::Block: if (buffer.size() >= BlockSize) flush(); break;
+	case FlushPolicy::Explicit: break;
+	}
+}
+
+void OutputBuffer::write(char ch)
+{
+	write(std::string_view(&ch, 1));
+}
+
+void OutputBuffer::flush()
+{
+	if (!buffer.empty())
+	{
+		std::fwrite(buffer.data(), 1, buffer.size(), file);
+		buffer.clear();
+	}
+	std::fflush(file);
+}
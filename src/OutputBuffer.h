@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstdio>
+
+//collects the output of the program and writes it to the file in big chunks instead of one call per print
+class OutputBuffer
+{
+public:
+	enum class FlushPolicy
+	{
+		Line, //flush after every '\n' (default when stdout is a console)
+		Block, //flush whenever BlockSize bytes are collected (default when stdout is a pipe or file)
+		Explicit, //only flush on leerePuffer(), before reading input and at the end of the program
+	};
+public:
+	OutputBuffer(std::FILE* file, FlushPolicy policy);
+	~OutputBuffer(); //flushes the remaining output
+
+	OutputBuffer(const OutputBuffer&) = delete;
+	OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+	void write(std::string_view str);
+	void write(char ch);
+	void flush(); //write everything collected so far to the file
+
+	//so Value::print can write into the buffer like into a std::ostream
+	OutputBuffer& operator<<(std::string_view str) { write(str); return *this; }
+	OutputBuffer& operator<<(const std::string& str) { write(str); return *this; }
+	OutputBuffer& operator<<(const char* str) { write(std::string_view(str)); return *this; }
+	OutputBuffer& operator<<(char ch) { write(ch); return *this; }
+private:
+	static constexpr size_t BlockSize = 1 << 16;
+
+	std::FILE* file;
+	FlushPolicy policy;
+	std::string buffer;
+};
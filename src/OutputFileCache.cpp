@@ -0,0 +1,40 @@
+#include "OutputFileCache.h"
+
+std::ofstream* OutputFileCache::get(const std::string& path)
+{
+	auto it = index.find(path);
+	if (it == index.end()) return nullptr;
+	files.splice(files.begin(), files, it->second);
+	return &it->second->second;
+}
+
+std::ofstream* OutputFileCache::open(const std::string& path)
+{
+	close(path);
+	if (files.size() >= Capacity)
+	{
+		index.erase(files.back().first);
+		files.pop_back();
+	}
+
+	std::ofstream ofs(path, std::ofstream::app);
+	if (!ofs.is_open()) return nullptr;
+
+	files.emplace_front(path, std::move(ofs));
+	index[path] = files.begin();
+	return &files.front().second;
+}
+
+void OutputFileCache::close(const std::string& path)
+{
+	auto it = index.find(path);
+	if (it == index.end()) return;
+	files.erase(it->second);
+	index.erase(it);
+}
+
+void OutputFileCache::flushAll()
+{
+	for (auto& file : files)
+		file.second.flush();
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+#include <fstream>
+#include <list>
+#include <unordered_map>
+
+//keeps the files bearbeiteDatei appends to open between calls, so appending does not cost an open and a close every time.
+//At most Capacity files are open at once, the least recently used one is closed first
+class OutputFileCache
+{
+public:
+	std::ofstream* get(const std::string& path); //the open stream of path or nullptr if it is not open
+	std::ofstream* open(const std::string& path); //open path for appending, nullptr if it could not be opened
+	void close(const std::string& path); //flush and close path if it is open
+	void flushAll(); //so the files can be read
+private:
+	static constexpr size_t Capacity = 16;
+
+	std::list<std::pair<std::string, std::ofstream>> files; //most recently used first
+	std::unordered_map<std::string, std::list<std::pair<std::string, std::ofstream>>::iterator> index; //path -> element in files
+};
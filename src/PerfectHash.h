@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+constexpr size_t log2Ceil(size_t n)
+{
+	size_t bits = 0;
+	while (((size_t)1 << bits) < n) bits++;
+	return bits;
+}
+
+//a key of a PerfectHash and the value it maps to
+template<typename T>
+struct HashEntry
+{
+	std::string_view key;
+	T value;
+};
+
+//hash table for a fixed set of string keys which is built at compile time and never has collisions (hash and displace).
+//A key is hashed once, the hash selects a bucket and the displacement of that bucket scrambles the hash into a slot no other key uses,
+//so a lookup is one hash, two array accesses and one string compare
+template<typename T, size_t N>
+class PerfectHash
+{
+public:
+	constexpr PerfectHash(const HashEntry<T>(&entries)[N])
+		:
+		displacements{},
+		slots{},
+		valid(true)
+	{
+		//everything here runs in the constexpr evaluation, which compilers limit in steps (MSVC /constexpr:steps, gcc -fconstexpr-ops-limit).
+		//So the keys are grouped by bucket with counting sorts, a displacement is only tried against the keys of its own bucket
+		//and plain arrays are used, because every std::array::operator[] is a counted call
+		uint64_t hashes[N]{};
+		size_t bucketStart[Buckets + 1]{};
+		for (size_t i = 0; i < N; i++)
+		{
+			hashes[i] = hash(entries[i].key);
+			bucketStart[hashes[i] % Buckets + 1]++;
+		}
+		for (size_t bucket = 0; bucket < Buckets; bucket++)
+			bucketStart[bucket + 1] += bucketStart[bucket];
+		size_t order[N]{}; //indices of the entries, grouped by bucket
+		size_t filled[Buckets]{};
+		for (size_t i = 0; i < N; i++)
+		{
+			size_t bucket = hashes[i] % Buckets;
+			order[bucketStart[bucket] + filled[bucket]++] = i;
+		}
+
+		//place the biggest buckets first, they are the hardest to fit (bucketOrder is sorted by size ascending)
+		size_t sizeStart[N + 2]{};
+		for (size_t bucket = 0; bucket < Buckets; bucket++)
+			sizeStart[bucketStart[bucket + 1] - bucketStart[bucket] + 1]++;
+		for (size_t size = 0; size <= N; size++)
+			sizeStart[size + 1] += sizeStart[size];
+		size_t bucketOrder[Buckets]{};
+		for (size_t bucket = 0; bucket < Buckets; bucket++)
+			bucketOrder[--sizeStart[bucketStart[bucket + 1] - bucketStart[bucket] + 1]] = bucket;
+
+		bool used[Slots]{};
+		size_t bucketSlots[N]{};
+		for (size_t k = Buckets; k > 0; k--)
+		{
+			const size_t bucket = bucketOrder[k - 1];
+			const size_t begin = bucketStart[bucket], end = bucketStart[bucket + 1];
+			if (end == begin) break;
+
+			//equal hashes can never be seperated (and mean the same key was given twice), they always land in the same bucket
+			for (size_t i = begin; i < end; i++)
+				for (size_t j = i + 1; j < end; j++)
+					if (hashes[order[i]] == hashes[order[j]])
+					{
+						valid = false;
+						return;
+					}
+
+			uint64_t d = 0;
+			for (;; d++)
+			{
+				if (d > MaxDisplacement)
+				{
+					valid = false;
+					return;
+				}
+				bool fits = true;
+				for (size_t i = begin; i < end && fits; i++)
+				{
+					size_t s = slot(hashes[order[i]], d);
+					if (used[s]) fits = false;
+					for (size_t j = begin; j < i && fits; j++)
+						if (bucketSlots[j - begin] == s) fits = false;
+					bucketSlots[i - begin] = s;
+				}
+				if (fits) break;
+			}
+
+			displacements[bucket] = d;
+			for (size_t i = begin; i < end; i++)
+			{
+				used[bucketSlots[i - begin]] = true;
+				slots[bucketSlots[i - begin]] = entries[order[i]];
+			}
+		}
+	}
+
+	//returns a pointer to the value of key or nullptr if key is not in the table
+	constexpr const T* find(std::string_view key) const
+	{
+		const uint64_t h = hash(key);
+		const HashEntry<T>& entry = slots[slot(h, displacements[h % Buckets])];
+		return (!key.empty() && entry.key == key) ? &entry.value : nullptr;
+	}
+
+	//false if the table could not be built (duplicate keys)
+	constexpr bool isValid() const { return valid; }
+private:
+	static constexpr size_t Buckets = N;
+	static constexpr size_t SlotBits = log2Ceil(2 * N); //keep the table at most half full
+	static constexpr size_t Slots = (size_t)1 << SlotBits;
+	static constexpr uint64_t MaxDisplacement = 1 << 16;
+
+	//FNV-1a
+	static constexpr uint64_t hash(std::string_view key)
+	{
+		uint64_t h = 14695981039346656037ull;
+		for (char c : key)
+		{
+			h ^= (uint8_t)c;
+			h *= 1099511628211ull;
+		}
+		return h;
+	}
+
+	static constexpr size_t slot(uint64_t h, uint64_t displacement)
+	{
+		return (size_t)(((h ^ displacement) * 0x9E3779B97F4A7C15ull) >> (64 - SlotBits));
+	}
+
+	std::array<uint64_t, Buckets> displacements;
+	std::array<HashEntry<T>, Slots> slots;
+	bool valid;
+};
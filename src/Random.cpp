@@ -0,0 +1,65 @@
+#include "Random.h"
+
+static inline uint64_t rotl(uint64_t x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+Random::Random(uint64_t seed)
+{
+	//splitmix64 spreads the seed over the whole state, so small seeds like 1 or 2 give good numbers too
+	for (uint64_t& s : state)
+	{
+		seed += 0x9e3779b97f4a7c15;
+		uint64_t z = seed;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+		s = z ^ (z >> 31);
+	}
+}
+
+uint64_t Random::next()
+{
+	const uint64_t result = rotl(state[1] * 5, 7) * 9;
+	const uint64_t t = state[1] << 17;
+
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+
+	state[2] ^= t;
+	state[3] = rotl(state[3], 45);
+
+	return result;
+}
+
+int Random::nextInt(int min, int max)
+{
+	if (min > max)
+	{
+		int tmp = min;
+		min = max;
+		max = tmp;
+	}
+
+	const uint64_t range = (uint64_t)((int64_t)max - (int64_t)min) + 1;
+	if (range > UINT32_MAX) return (int)(uint32_t)(next() >> 32); //every int is possible
+
+	//Lemire's multiply and shift, rejecting the few values that would make some results more likely than others
+	uint64_t m = (next() >> 32) * range;
+	if ((uint32_t)m < range)
+	{
+		const uint32_t threshold = (uint32_t)((UINT32_MAX - range + 1) % range);
+		while ((uint32_t)m < threshold)
+			m = (next() >> 32) * range;
+	}
+	return (int)((int64_t)min + (int64_t)(m >> 32));
+}
+
+double Random::nextDouble(double min, double max)
+{
+	//the upper 53 bits fill the mantissa of a double in [0, 1)
+	const double unit = (double)(next() >> 11) * (1.0 / 9007199254740992.0);
+	return min + unit * (max - min);
+}
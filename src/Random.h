@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+//xoshiro256** (https://prng.di.unimi.it/), one per program so the random natives neither seed a new generator nor ask the os on every call
+class Random
+{
+public:
+	Random(uint64_t seed);
+
+	uint64_t next();
+	int nextInt(int min, int max); //uniform in [min, max]
+	double nextDouble(double min, double max); //uniform in [min, max)
+private:
+	uint64_t state[4];
+};
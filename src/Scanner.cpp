@@ -5,9 +5,11 @@
 
 using namespace std::string_literals;
 
-Scanner::Scanner(const std::string& file)
+Scanner::Scanner(const std::string& file, SourceArena* arena)
 	:
 	filePath(file),
+	arena(arena),
+	source(arena->emplace_back()),
 	line(1),
 	depth(0),
 	hadError(false)
@@ -19,7 +21,15 @@ Scanner::Scanner(const std::string& file)
 		std::cerr << u8"Could not open the source file '" << file << "'!\n";
 		hadError = true;
 	}
-	source = std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+	else
+	{
+		//read the whole file at once instead of char by char
+		ifs.seekg(0, std::ios::end);
+		source.resize(static_cast<size_t>(ifs.tellg()));
+		ifs.seekg(0, std::ios::beg);
+		ifs.read(source.data(), source.size());
+		source.resize(static_cast<size_t>(ifs.gcount())); //text mode may have dropped some '\r'
+	}
 	source.push_back('\0');
 	start = source.begin();
 	current = source.begin();
@@ -31,192 +41,137 @@ void Scanner::error(const std::string& msg, int line)
 	hadError = true;
 }
 
-void Scanner::consume(TokenType type, const std::string& msg, std::vector<Token>::iterator& it, std::vector<Token>& vec)
+Token Scanner::nextToken()
 {
-	if (it >= vec.end() - 1)
-	{
-		error(msg, (it - 1)->line);
-		return;
-	}
-	if ((it + 1)->type != type)
-	{
-		error(msg, it->line);
-		return;
-	}
-	it++;
+	if (lookahead.empty()) return scanToken();
+	Token t = std::move(lookahead.front());
+	lookahead.pop_front();
+	return t;
 }
 
-void Scanner::consumeErase(TokenType type, const std::string& msg, std::vector<Token>::iterator& it, std::vector<Token>& vec)
+const Token& Scanner::peekToken(size_t offset)
 {
-	consume(type, msg, it, vec);
-	it = vec.erase(it) - 1; //set it to the element before the one that was erased
+	while (lookahead.size() <= offset)
+	{
+		//never scan past the end of the source
+		if (!lookahead.empty() && lookahead.back().type == TokenType::END)
+			return lookahead.back();
+		lookahead.push_back(scanToken());
+	}
+	return lookahead[offset];
 }
 
-bool Scanner::check(TokenType type, std::vector<Token>::iterator& it, std::vector<Token>& vec)
+void Scanner::consume(TokenType type, const std::string& msg, int line)
 {
-	if (it >= vec.end() - 1) return false;
-	return (it + 1)->type == type;
+	if (!check(type))
+	{
+		error(msg, line);
+		return;
+	}
+	lookahead.pop_front();
 }
 
-bool Scanner::check(TokenType type, std::vector<Token>::iterator& it, std::vector<Token>& vec, int offset)
+bool Scanner::check(TokenType type, size_t offset)
 {
-	if (it >= vec.end() - offset) return false;
-	return (it + offset)->type == type;
+	return peekToken(offset).type == type;
 }
 
 std::pair<std::vector<Token>, bool> Scanner::scanTokens()
 {
 	std::vector<Token> tokens;
-	for (Token t = scanToken(); t.type != TokenType::END; t = scanToken())
-		tokens.push_back(t);
-	tokens.emplace_back(Token{ TokenType::END, "", depth, line });
+	tokens.reserve(source.size() / 4);
 
-	for (auto it = tokens.begin(); it != tokens.end(); it++)
+	for (Token t = nextToken(); t.type != TokenType::END; t = nextToken())
 	{
-		switch (it->type)
+		switch (t.type)
 		{
 		case TokenType::BINDE:
 		{
-			consume(TokenType::STRING, u8"Es wurde ein Text Literal nach 'binde' erwartet!", it, tokens);
-			std::string path(it->literal.begin() + 1, it->literal.end() - 1);
-			std::vector<Token> otherFile;
+			if (!check(TokenType::STRING))
 			{
-				Scanner otherFileScanner(path + ".ddp");
-				auto other = otherFileScanner.scanTokens();
-				if (!other.second)
-					error(u8"Could not open the source file '" + otherFileScanner.filePath + "'!", it->line);
-				otherFile = std::move(other.first);
+				error(u8"Es wurde ein Text Literal nach 'binde' erwartet!", t.line);
+				continue;
 			}
-			consume(TokenType::EIN, u8"Es wurde ein 'ein' beim einbinden einer weiteren Datei erwartet!", it, tokens);
-			consume(TokenType::DOT, u8"Es wurde ein '.' nach dem einbinden einer weiteren Datei erwartet!", it, tokens);
-			auto after = tokens.erase(it - 3, it + 1);
-			auto before = tokens.insert(after, otherFile.begin(), otherFile.end() - 1);
-			it = before + otherFile.size() - 2;
-			break;
-		}
-		case TokenType::BETRAG:
-		{
-			consumeErase(TokenType::VON, u8"Nach 'Betrag' muss 'von' stehen!", it, tokens);
-			break;
-		}
-		case TokenType::SIN:
-		{
-			consumeErase(TokenType::VON, u8"Nach 'Sinus' muss 'von' stehen!", it, tokens);
-			break;
-		}
-		case TokenType::COS:
-		{
-			consumeErase(TokenType::VON, u8"Nach 'Kosinus' muss 'von' stehen!", it, tokens);
-			break;
-		}case TokenType::TAN:
-		{
-			consumeErase(TokenType::VON, u8"Nach 'Tangens' muss 'von' stehen!", it, tokens);
-			break;
-		}case TokenType::ASIN:
-		{
-			consumeErase(TokenType::VON, u8"Nach 'Arkussinus' muss 'von' stehen!", it, tokens);
-			break;
-		}case TokenType::ACOS:
-		{
-			consumeErase(TokenType::VON, u8"Nach 'Arkuskosinus' muss 'von' stehen!", it, tokens);
-			break;
-		}case TokenType::ATAN:
-		{
-			consumeErase(TokenType::VON, u8"Nach 'Arkustangens' muss 'von' stehen!", it, tokens);
-			break;
-		}case TokenType::SINH:
-		{
-			consumeErase(TokenType::VON, u8"Nach 'Hyperbelsinus' muss 'von' stehen!", it, tokens);
-			break;
-		}case TokenType::COSH:
-		{
-			consumeErase(TokenType::VON, u8"Nach 'Hyperbelcosinus' muss 'von' stehen!", it, tokens);
-			break;
-		}case TokenType::TANH:
-		{
-			consumeErase(TokenType::VON, u8"Nach 'Hyperbeltangens' muss 'von' stehen!", it, tokens);
-			break;
+			Token pathToken = nextToken();
+			std::string path(pathToken.literal.begin() + 1, pathToken.literal.end() - 1);
+			consume(TokenType::EIN, u8"Es wurde ein 'ein' beim einbinden einer weiteren Datei erwartet!", t.line);
+			consume(TokenType::DOT, u8"Es wurde ein '.' nach dem einbinden einer weiteren Datei erwartet!", t.line);
+
+			Scanner otherFileScanner(path + ".ddp", arena);
+			auto other = otherFileScanner.scanTokens();
+			if (!other.second)
+				error(u8"Could not open the source file '" + otherFileScanner.filePath + "'!", t.line);
+			tokens.insert(tokens.end(), std::make_move_iterator(other.first.begin()), std::make_move_iterator(other.first.end() - 1)); //without the END token
+			continue;
 		}
+		case TokenType::BETRAG: consume(TokenType::VON, u8"Nach 'Betrag' muss 'von' stehen!", t.line); break;
+		case TokenType::SIN: consume(TokenType::VON, u8"Nach 'Sinus' muss 'von' stehen!", t.line); break;
+		case TokenType::COS: consume(TokenType::VON, u8"Nach 'Kosinus' muss 'von' stehen!", t.line); break;
+		case TokenType::TAN: consume(TokenType::VON, u8"Nach 'Tangens' muss 'von' stehen!", t.line); break;
+		case TokenType::ASIN: consume(TokenType::VON, u8"Nach 'Arkussinus' muss 'von' stehen!", t.line); break;
+		case TokenType::ACOS: consume(TokenType::VON, u8"Nach 'Arkuskosinus' muss 'von' stehen!", t.line); break;
+		case TokenType::ATAN: consume(TokenType::VON, u8"Nach 'Arkustangens' muss 'von' stehen!", t.line); break;
+		case TokenType::SINH: consume(TokenType::VON, u8"Nach 'Hyperbelsinus' muss 'von' stehen!", t.line); break;
+		case TokenType::COSH: consume(TokenType::VON, u8"Nach 'Hyperbelcosinus' muss 'von' stehen!", t.line); break;
+		case TokenType::TANH: consume(TokenType::VON, u8"Nach 'Hyperbeltangens' muss 'von' stehen!", t.line); break;
 		case TokenType::LOGISCH:
 		{
-			if (check(TokenType::NICHT, it, tokens))
+			if (check(TokenType::NICHT))
 			{
-				it->type = TokenType::LOGISCHNICHT;
-				consumeErase(TokenType::NICHT, "", it, tokens);
+				t.type = TokenType::LOGISCHNICHT;
+				consume(TokenType::NICHT, "", t.line);
 			}
 			break;
 		}
 		case TokenType::GROESSER:
+		case TokenType::KLEINER:
 		{
-			if (check(TokenType::ALS, it, tokens))
+			const bool groesser = t.type == TokenType::GROESSER;
+			if (!check(TokenType::ALS))
 			{
-				if (check(TokenType::COMMA, it, tokens, 2))
-				{
-					if (check(TokenType::ODER, it, tokens, 3))
-					{
-						consumeErase(TokenType::ALS, "", it, tokens);
-						consumeErase(TokenType::COMMA, "", it, tokens);
-						consumeErase(TokenType::ODER, "", it, tokens);
-						it->type = TokenType::GROESSERODER;
-					}
-					else
-						error(u8"Nach 'grer als,' muss ein 'oder' stehen!", it->line);
-				}
-				else
-					consumeErase(TokenType::ALS, "", it, tokens);
+				error(groesser ? u8"Nach 'grer' fehlt 'als'!" : u8"Nach 'kleiner' fehlt 'als'!", t.line);
+				break;
 			}
-			else
-				error(u8"Nach 'grer' fehlt 'als'!", it->line);
-			break;
-		}
-		case TokenType::KLEINER:
-		{
-			if (check(TokenType::ALS, it, tokens))
+			consume(TokenType::ALS, "", t.line);
+			if (check(TokenType::COMMA))
 			{
-				if (check(TokenType::COMMA, it, tokens, 2))
+				if (check(TokenType::ODER, 1))
 				{
-					if (check(TokenType::ODER, it, tokens, 3))
-					{
-						consumeErase(TokenType::ALS, "", it, tokens);
-						consumeErase(TokenType::COMMA, "", it, tokens);
-						consumeErase(TokenType::ODER, "", it, tokens);
-						it->type = TokenType::KLEINERODER;
-					}
-					else
-						error(u8"Nach 'kleiner als,' muss ein 'oder' stehen!", it->line);
+					consume(TokenType::COMMA, "", t.line);
+					consume(TokenType::ODER, "", t.line);
+					t.type = groesser ? TokenType::GROESSERODER : TokenType::KLEINERODER;
 				}
 				else
-					consumeErase(TokenType::ALS, "", it, tokens);
+					error(groesser ? u8"Nach 'grer als,' muss ein 'oder' stehen!" : u8"Nach 'kleiner als,' muss ein 'oder' stehen!", t.line);
 			}
-			else
-				error(u8"Nach 'kleiner' fehlt 'als'!", it->line);
 			break;
 		}
 		case TokenType::INUMBER:
 		{
-			if (check(TokenType::DOT, it, tokens))
+			if (check(TokenType::DOT) && check(TokenType::WURZEL, 1))
 			{
-				if (check(TokenType::WURZEL, it, tokens, 2))
-				{
-					consumeErase(TokenType::DOT, "", it, tokens);
-					it++;
-					consumeErase(TokenType::VON, u8"Es wurde ein 'von' nach 'wurzel' erwartet!", it, tokens);
-				}
+				consume(TokenType::DOT, "", t.line);
+				tokens.push_back(std::move(t));
+				t = nextToken(); //the WURZEL token
+				consume(TokenType::VON, u8"Es wurde ein 'von' nach 'wurzel' erwartet!", t.line);
 			}
 			break;
 		}
 		case TokenType::AN:
 		{
-			consumeErase(TokenType::DER, u8"Nach 'an' wurde 'der' erwartet!", it, tokens);
-			consumeErase(TokenType::STELLE, u8"Nach, 'der' wurde 'Stelle' erwartet!", it, tokens);
+			consume(TokenType::DER, u8"Nach 'an' wurde 'der' erwartet!", t.line);
+			consume(TokenType::STELLE, u8"Nach, 'der' wurde 'Stelle' erwartet!", t.line);
 			break;
 		}
 		default:
 			break;
 		}
+		tokens.push_back(std::move(t));
 	}
+	tokens.emplace_back(Token{ TokenType::END, "", depth, line });
+
 	tokens.shrink_to_fit();
-	return std::make_pair(tokens, !hadError);
+	return std::make_pair(std::move(tokens), !hadError);
 }
 
 Token Scanner::scanToken()
@@ -264,11 +219,11 @@ Token Scanner::makeToken(TokenType type) const
 	token.depth = depth;
 	token.type = type;
 	token.line = line;
-	token.literal = std::string(start, current);
+	token.literal = std::string_view(&*start, current - start);
 	return token;
 }
 
-Token Scanner::errorToken(std::string msg) const
+Token Scanner::errorToken(std::string_view msg) const
 {
 	Token token;
 	token.type = TokenType::ERROR;
@@ -330,9 +285,7 @@ void Scanner::skipWhitespaces()
 Token Scanner::identifier()
 {
 	while (isAlphabetical(peek(), false) || isDigit(peek())) advance();
-	std::string identifier(start, current);
-
-	if (keywords.find(identifier) != keywords.end()) return makeToken(keywords.at(identifier));
+	if (const TokenType* keyword = keywords.find(std::string_view(&*start, current - start))) return makeToken(*keyword);
 
 	return makeToken(TokenType::IDENTIFIER);
 }
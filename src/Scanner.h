@@ -1,8 +1,11 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
+#include <deque>
+#include <iterator>
+#include "PerfectHash.h"
 
 enum class TokenType
 {
@@ -17,7 +20,7 @@ enum class TokenType
 	SIN, COS, TAN, ASIN, ACOS, ATAN, SINH, COSH, TANH,
 	//boolsche operatoren
 	UND, ODER, NICHT,
-	KLEINER, GROESSER, ALS, KLEINERODER, GROESSERODER, UNGLEICH, GLEICH,
+	KLEINER, GROESSER, ALS, KLEINERODER, GROESSERODER, UNGLEICH, GLEICH, ENTHAELT,
 	//bitshifting
 	UM, BIT, NACH, RECHTS, LINKS, VERSCHOBEN,
 	//bitwise
@@ -25,7 +28,7 @@ enum class TokenType
 	//if
 	WENN, ABER, DANN, SONST,
 	//for
-	FUER, JEDE, VON, BIS, MIT, SCHRITTGROESSE,
+	FUER, JEDE, VON, BIS, MIT, SCHRITTGROESSE, PARALLEL, IN,
 	//while
 	SOLANGE,
 	//loops
@@ -35,17 +38,21 @@ enum class TokenType
 	//assignement
 	IST, SIND,
 	//Artikel
-	DER, DIE,// DAS,
+	DER, DIE, DAS,
 	//Typen
 	ZAHL, KOMMAZAHL, BOOLEAN, BUCHSTABE, TEXT,
 	//Arrays
-	ZAHLEN, KOMMAZAHLEN, BOOLEANS, BUCHSTABEN, TEXTE, STRUKTUR, STRUKTUREN, AN, STELLE, STUECK, LEFT_SQAREBRACKET, RIGHT_SQAREBRACKET, SEMICOLON,
+	ZAHLEN, KOMMAZAHLEN, BOOLEANS, BUCHSTABEN, TEXTE, BYTES, MATRIX, WOERTERBUCH, STRUKTUR, STRUKTUREN, AN, STELLE, STUECK, LEFT_SQAREBRACKET, RIGHT_SQAREBRACKET, SEMICOLON,
 	//structs
 	BESCHREIBT,
+	//dictionaries
+	ENTFERNE, AUS,
 	//bool literals
 	WAHR, FALSCH,
 	//return
 	GIB, ZURUECK,
+	//tasks
+	STARTE, ERWARTE, EMPFANGE,
 #ifndef NDEBUG
 	PRINT,
 #endif
@@ -58,15 +65,19 @@ enum class TokenType
 struct Token
 {
 	TokenType type = TokenType::ERROR;
-	std::string literal = u8"";
+	std::string_view literal = u8""; //view into the SourceArena (or a static error message)
 	int depth = 0;
 	int line = 1;
 };
 
+//holds the source code of every scanned file (included ones too)
+//the tokens only view into it, so it has to outlive them
+using SourceArena = std::deque<std::string>;
+
 class Scanner
 {
 public:
-	Scanner(const std::string& file);
+	Scanner(const std::string& file, SourceArena* arena);
 
 	std::pair<std::vector<Token>, bool> scanTokens(); //the bool is false if an error occured, but even if that happened the vector may still be used
 private:
@@ -75,7 +86,7 @@ private:
 
 	bool isAtEnd() const;
 	Token makeToken(TokenType type) const;
-	Token errorToken(std::string msg) const;
+	Token errorToken(std::string_view msg) const; //msg must be a string literal
 	void skipWhitespaces();
 
 	Token identifier();
@@ -95,15 +106,18 @@ private:
 	//helper for scanTokens
 	void error(const std::string& msg, int line);
 
-	void consume(TokenType type, const std::string& msg, std::vector<Token>::iterator& it, std::vector<Token>& vec);
-	void consumeErase(TokenType type, const std::string& msg, std::vector<Token>::iterator& it, std::vector<Token>& vec);
-	bool check(TokenType type, std::vector<Token>::iterator& it, std::vector<Token>& vec);
-	bool check(TokenType type, std::vector<Token>::iterator& it, std::vector<Token>& vec, int offset);
+	//multi-word forms (like 'grer als, oder') are rewritten while the tokens are produced,
+	//so these helpers work on a small lookahead buffer instead of the finished token vector
+	Token nextToken(); //pop the next token from the lookahead (or scan a new one)
+	const Token& peekToken(size_t offset); //peek <offset> tokens ahead, scanning as needed
+	void consume(TokenType type, const std::string& msg, int line); //drop the next token if it has the given type, else report an error
+	bool check(TokenType type, size_t offset = 0); //true if the token <offset> ahead has the given type
 private:
 	const std::string filePath;
-	std::string source; //the source code read from filePath
+	SourceArena* arena; //where the source of included files is stored
+	std::string& source; //the source code read from filePath, owned by arena
 
-	static inline const std::unordered_map<std::string, TokenType> keywords = {
+	static constexpr HashEntry<TokenType> keywordList[] = {
 		{u8"plus", TokenType::PLUS},
 		{u8"minus", TokenType::MINUS},
 		{u8"mal", TokenType::MAL},
@@ -126,6 +140,8 @@ private:
 		{u8"als", TokenType::ALS},
 		{u8"ungleich", TokenType::UNGLEICH},
 		{u8"gleich", TokenType::GLEICH},
+		{u8"enthlt", TokenType::ENTHAELT},
+		{u8"enthaelt", TokenType::ENTHAELT},
 		{u8"um", TokenType::UM},
 		{u8"bit", TokenType::BIT},
 		{u8"nach", TokenType::NACH},
@@ -141,11 +157,14 @@ private:
 		{u8"fr", TokenType::FUER},
 		{u8"fuer", TokenType::FUER},
 		{u8"jede", TokenType::JEDE},
+		{u8"jeden", TokenType::JEDE},
 		{u8"von", TokenType::VON},
 		{u8"bis", TokenType::BIS},
 		{u8"mit", TokenType::MIT},
 		{u8"schrittgre", TokenType::SCHRITTGROESSE},
 		{u8"schrittgroesse", TokenType::SCHRITTGROESSE},
+		{u8"parallel", TokenType::PARALLEL},
+		{u8"in", TokenType::IN},
 		{u8"solange", TokenType::SOLANGE},
 		{u8"mache", TokenType::MACHE},
 		{u8"Funktion", TokenType::FUNKTION},
@@ -156,6 +175,7 @@ private:
 		{u8"sind", TokenType::SIND},
 		{u8"der", TokenType::DER},
 		{u8"die", TokenType::DIE},
+		{u8"das", TokenType::DAS},
 		{u8"Zahl", TokenType::ZAHL},
 		{u8"Kommazahl", TokenType::KOMMAZAHL},
 		{u8"Boolean", TokenType::BOOLEAN},
@@ -166,6 +186,10 @@ private:
 		{u8"Booleans", TokenType::BOOLEANS},
 		{u8"Buchstaben", TokenType::BUCHSTABEN},
 		{u8"Texte", TokenType::TEXTE},
+		{u8"Bytes", TokenType::BYTES},
+		{u8"Matrix", TokenType::MATRIX},
+		{u8"Wrterbuch", TokenType::WOERTERBUCH},
+		{u8"Woerterbuch", TokenType::WOERTERBUCH},
 		{u8"an", TokenType::AN},
 		{u8"Stelle", TokenType::STELLE},
 		{u8"Stck", TokenType::STUECK},
@@ -175,6 +199,9 @@ private:
 		{u8"gib", TokenType::GIB},
 		{u8"zurck", TokenType::ZURUECK},
 		{u8"zurueck", TokenType::ZURUECK},
+		{u8"starte", TokenType::STARTE},
+		{u8"erwarte", TokenType::ERWARTE},
+		{u8"empfange", TokenType::EMPFANGE},
 		{u8"binde", TokenType::BINDE},
 		{u8"ein", TokenType::EIN},
 		{u8"Sinus", TokenType::SIN},
@@ -189,12 +216,18 @@ private:
 		{u8"Struktur", TokenType::STRUKTUR},
 		{u8"Strukturen", TokenType::STRUKTUREN},
 		{u8"beschreibt", TokenType::BESCHREIBT},
+		{u8"entferne", TokenType::ENTFERNE},
+		{u8"aus", TokenType::AUS},
 	};
+	static constexpr PerfectHash<TokenType, std::size(keywordList)> keywords{ keywordList }; //built at compile time
+	static_assert(keywords.isValid(), "the keyword list contains a keyword twice");
 
 	std::string::iterator start; //start of the current token
 	std::string::iterator current; //one after the current character
 	int line; //current line in the source code
 	int depth; //current scope depth of the token
 	bool hadError; //indicates if the scanner errored
+
+	std::deque<Token> lookahead; //scanned tokens that were not rewritten yet
 };
 
@@ -0,0 +1,175 @@
+#include "TaskPool.h"
+#include "Natives.h"
+#include <algorithm>
+
+static thread_local bool inPool = false; //true on the threads of the pool
+
+TaskPool::TaskPool()
+	:
+	//tasks often wait for files, so there are more threads than cores on small machines
+	threadCount(std::max(4u, std::thread::hardware_concurrency())),
+	isStarted(false),
+	blocked(0),
+	nextId(1),
+	stopping(false)
+{}
+
+TaskPool::~TaskPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+int TaskPool::start(Job job)
+{
+	auto task = std::make_shared<Task>();
+	task->job = std::move(job);
+
+	int id;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (threads.empty())
+		{
+			isStarted = true;
+			for (size_t i = 0; i < threadCount; i++)
+				startThread();
+		}
+		else if (blocked == threads.size())
+			startThread();
+		id = nextId++;
+		tasks.emplace(id, task);
+		queue.push_back(task);
+	}
+	wake.notify_one();
+	return id;
+}
+
+Value TaskPool::wait(int id)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	auto it = tasks.find(id);
+	if (it == tasks.end())
+		throw runtime_error(u8"Es gibt keine laufende Aufgabe mit der Nummer " + std::to_string(id) + "!");
+	std::shared_ptr<Task> task = it->second;
+	tasks.erase(it);
+
+	//no thread took it yet, so instead of blocking one the task runs right here. This also means tasks awaiting tasks never run out of threads
+	if (task->state == State::Waiting)
+	{
+		task->state = State::Running;
+		lock.unlock();
+		run(*task);
+		lock.lock();
+	}
+	if (task->state != State::Done)
+	{
+		bool counted = beginBlocking();
+		done.wait(lock, [&] { return task->state == State::Done; });
+		if (counted) endBlocking();
+	}
+
+	if (task->error) std::rethrow_exception(task->error);
+	return std::move(task->result);
+}
+
+void TaskPool::waitForAll()
+{
+	while (true)
+	{
+		int id;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (tasks.empty()) return;
+			//the smallest id was started first, tasks can still start new ones while this waits
+			id = std::min_element(tasks.begin(), tasks.end(), [](auto& a, auto& b) { return a.first < b.first; })->first;
+		}
+		wait(id);
+	}
+}
+
+bool TaskPool::started() const
+{
+	return isStarted.load(std::memory_order_relaxed);
+}
+
+TaskPool::Blocking::Blocking(TaskPool& pool)
+	:
+	pool(pool)
+{
+	std::lock_guard<std::mutex> lock(pool.mutex);
+	counted = pool.beginBlocking();
+}
+
+TaskPool::Blocking::~Blocking()
+{
+	if (!counted) return;
+	std::lock_guard<std::mutex> lock(pool.mutex);
+	pool.endBlocking();
+}
+
+void TaskPool::startThread()
+{
+	threads.emplace_back(&TaskPool::threadMain, this);
+}
+
+bool TaskPool::beginBlocking()
+{
+	if (!inPool) return false;
+	blocked++;
+	if (blocked == threads.size() && !queue.empty())
+		startThread();
+	return true;
+}
+
+void TaskPool::endBlocking()
+{
+	blocked--;
+}
+
+void TaskPool::threadMain()
+{
+	inPool = true;
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		wake.wait(lock, [this] { return stopping || !queue.empty(); });
+		if (queue.empty()) return; //stopping and nothing left to run
+
+		std::shared_ptr<Task> task = std::move(queue.front());
+		queue.pop_front();
+		if (task->state != State::Waiting) continue; //already run by wait
+		task->state = State::Running;
+
+		lock.unlock();
+		run(*task);
+		lock.lock();
+	}
+}
+
+void TaskPool::run(Task& task)
+{
+	Value result;
+	std::exception_ptr error;
+	try
+	{
+		result = task.job();
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		task.result = std::move(result);
+		task.error = error;
+		task.state = State::Done;
+		task.job = nullptr; //free the copy of the function and its arguments
+	}
+	done.notify_all();
+}
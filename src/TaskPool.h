@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Value.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//runs the tasks started with 'starte' on a few threads and keeps their results until they are awaited with 'erwarte'
+class TaskPool
+{
+public:
+	using Job = std::function<Value()>;
+
+	TaskPool(); //the threads are only started by the first task, so programs without tasks stay single threaded
+	~TaskPool(); //runs the tasks that did not start yet and waits for all of them
+
+	TaskPool(const TaskPool&) = delete;
+	TaskPool& operator=(const TaskPool&) = delete;
+
+	int start(Job job); //queue job and return the number the program knows the task by
+	//wait until the task with the number id is done and return its result. A task that did not start yet runs on the calling thread.
+	//An exception thrown by the task is rethrown here
+	Value wait(int id);
+	//wait for the tasks that were never awaited, in the order they were started.
+	//The first exception one of them threw is rethrown, so it is not lost when the program ends
+	void waitForAll();
+
+	bool started() const; //true once the first task was started, from then on the global variables are shared between threads
+
+	//held by a task while it waits for another one, for example on a full channel.
+	//If every thread of the pool waits, another one is started so the tasks that are waited for can still run
+	class Blocking
+	{
+	public:
+		Blocking(TaskPool& pool);
+		~Blocking();
+	private:
+		TaskPool& pool;
+		bool counted;
+	};
+private:
+	enum class State
+	{
+		Waiting,
+		Running,
+		Done
+	};
+
+	struct Task
+	{
+		Job job;
+		State state = State::Waiting;
+		Value result;
+		std::exception_ptr error;
+	};
+
+	void startThread(); //mutex has to be held
+	//count the calling thread as waiting, if it belongs to the pool. mutex has to be held
+	bool beginBlocking();
+	void endBlocking();
+	void threadMain();
+	void run(Task& task); //run the job of task and wake the threads waiting for it
+
+	const size_t threadCount;
+	std::vector<std::thread> threads;
+	std::atomic<bool> isStarted;
+	size_t blocked; //the threads of the pool that are waiting inside a Blocking
+
+	std::unordered_map<int, std::shared_ptr<Task>> tasks; //the tasks that were not awaited yet
+	std::deque<std::shared_ptr<Task>> queue; //the tasks in the order they were started, some might already run because they were awaited
+	int nextId;
+
+	std::mutex mutex;
+	std::condition_variable wake; //signals the threads that a task was queued (or that they should stop)
+	std::condition_variable done; //signals wait that a task finished
+	bool stopping;
+};
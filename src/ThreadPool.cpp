@@ -0,0 +1,167 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+static thread_local bool runsBody = false;
+
+static uint64_t packRange(uint32_t begin, uint32_t end)
+{
+	return ((uint64_t)begin << 32) | end;
+}
+
+ThreadPool::ThreadPool()
+	:
+	threadCount(std::max(1u, std::thread::hardware_concurrency())),
+	body(nullptr),
+	grain(1),
+	cancelled(false),
+	generation(0),
+	running(0),
+	stopping(false)
+{}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+size_t ThreadPool::size() const
+{
+	return threadCount;
+}
+
+bool ThreadPool::isWorker()
+{
+	return runsBody;
+}
+
+void ThreadPool::start()
+{
+	ranges = std::make_unique<Range[]>(threadCount);
+	for (size_t i = 0; i < threadCount; i++)
+		ranges[i].bounds.store(0);
+	//the calling thread is worker 0
+	for (size_t i = 1; i < threadCount; i++)
+		threads.emplace_back(&ThreadPool::threadMain, this, i);
+}
+
+void ThreadPool::forEach(uint32_t count, const Body& body)
+{
+	if (count == 0) return;
+	std::lock_guard<std::mutex> exclusive(busy); //tasks can start loops at the same time, they run one after the other
+	if (ranges == nullptr) start();
+
+	//small enough to balance the load, big enough that taking a chunk costs nothing compared to running it
+	grain = std::clamp<uint32_t>(count / (uint32_t)(threadCount * 16), 1, 1024);
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		uint32_t begin = (uint32_t)((uint64_t)count * i / threadCount);
+		uint32_t end = (uint32_t)((uint64_t)count * (i + 1) / threadCount);
+		ranges[i].bounds.store(packRange(begin, end));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->body = &body;
+		cancelled = false;
+		error = nullptr;
+		running = threadCount - 1;
+		generation++;
+	}
+	wake.notify_all();
+
+	work(0);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this] { return running == 0; });
+	this->body = nullptr;
+	if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::threadMain(size_t worker)
+{
+	uint64_t seenGeneration = 0;
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		wake.wait(lock, [&] { return stopping || generation != seenGeneration; });
+		if (stopping) return;
+		seenGeneration = generation;
+
+		lock.unlock();
+		work(worker);
+		lock.lock();
+
+		if (--running == 0) done.notify_one();
+	}
+}
+
+void ThreadPool::work(size_t worker)
+{
+	runsBody = true;
+	uint32_t begin, end;
+	while (!cancelled.load(std::memory_order_relaxed))
+	{
+		if (pop(worker, begin, end))
+		{
+			try
+			{
+				(*body)(worker, begin, end);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!error) error = std::current_exception();
+				cancelled = true;
+			}
+		}
+		else if (!steal(worker))
+			break;
+	}
+	runsBody = false;
+}
+
+bool ThreadPool::pop(size_t worker, uint32_t& begin, uint32_t& end)
+{
+	std::atomic<uint64_t>& bounds = ranges[worker].bounds;
+	uint64_t old = bounds.load();
+	while (true)
+	{
+		uint32_t b = (uint32_t)(old >> 32), e = (uint32_t)old;
+		if (b >= e) return false;
+		uint32_t next = e - b > grain ? b + grain : e;
+		if (bounds.compare_exchange_weak(old, packRange(next, e)))
+		{
+			begin = b;
+			end = next;
+			return true;
+		}
+	}
+}
+
+bool ThreadPool::steal(size_t worker)
+{
+	for (size_t i = 1; i < threadCount; i++)
+	{
+		std::atomic<uint64_t>& victim = ranges[(worker + i) % threadCount].bounds;
+		uint64_t old = victim.load();
+		while (true)
+		{
+			uint32_t b = (uint32_t)(old >> 32), e = (uint32_t)old;
+			if (b >= e) break;
+			uint32_t middle = e - b > grain ? b + (e - b) / 2 : b;
+			if (victim.compare_exchange_weak(old, packRange(b, middle)))
+			{
+				//only thieves touch an empty range, and they leave it alone until it has iterations again
+				ranges[worker].bounds.store(packRange(middle, e));
+				return true;
+			}
+		}
+	}
+	return false;
+}
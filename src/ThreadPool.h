@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//runs the iterations of a parallel fuer loop on all cores.
+//Every thread starts with an equal part of the iterations and takes small chunks from its front,
+//a thread that runs out of work steals the back half of the part of another thread
+class ThreadPool
+{
+public:
+	using Body = std::function<void(size_t worker, uint32_t begin, uint32_t end)>; //run the iterations [begin, end) on the thread with the number worker
+
+	ThreadPool(); //the threads are only started by the first forEach, so programs without parallel loops stay single threaded
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	size_t size() const; //the number of threads forEach uses, including the calling one
+	//call body for every iteration in [0, count) and return when all are done.
+	//The first exception thrown by body stops the remaining iterations and is rethrown here
+	void forEach(uint32_t count, const Body& body);
+
+	static bool isWorker(); //true while the calling thread runs a body of forEach
+private:
+	void start();
+	void threadMain(size_t worker);
+	void work(size_t worker); //run chunks until no thread has iterations left
+	bool pop(size_t worker, uint32_t& begin, uint32_t& end); //take the next chunk of the own part
+	bool steal(size_t worker); //move the back half of the part of another thread into the own part
+
+	//begin in the upper, end in the lower 32 bits so both change together. On its own cache line so the threads don't slow each other down
+	struct alignas(64) Range
+	{
+		std::atomic<uint64_t> bounds;
+	};
+
+	const size_t threadCount;
+	std::vector<std::thread> threads;
+	std::unique_ptr<Range[]> ranges;
+
+	const Body* body; //the body of the current forEach
+	uint32_t grain; //the number of iterations taken at once
+	std::atomic<bool> cancelled; //set when a body threw
+	std::exception_ptr error; //the first exception thrown by a body
+
+	std::mutex busy; //held during a forEach
+	std::mutex mutex;
+	std::condition_variable wake; //signals the threads that a forEach started (or that they should stop)
+	std::condition_variable done; //signals forEach that all threads finished
+	uint64_t generation; //counts the calls to forEach, so the threads know when there is new work
+	size_t running; //the threads still working on the current forEach
+	bool stopping;
+};
@@ -1,8 +1,13 @@
 #include "Value.h"
+#include "Dictionary.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <sstream>
 
 bool isArr(Type t)
 {
-	return t >= Type::IntArr && t <= Type::StructArr;
+	return t >= Type::IntArr && t <= Type::Bytes;
 }
 
 bool isArr(ValueType t)
@@ -10,153 +15,69 @@ bool isArr(ValueType t)
 	return isArr(t.type);
 }
 
+Type elementType(Type arrType)
+{
+	if (arrType == Type::Bytes) return Type::Int;
+	return (Type)((int)arrType - 6); //the other array types come in the same order as their element types
+}
+
 Value::Value()
 	:
 	_val(std::monostate())
 {}
 
+//Only Text owns its pointer. Arrays and structs are shared between copies and never deleted,
+//the interpreter relies on that to assign members and elements through a copy and to read arrays without copying them
 Value::Value(const Value& other)
+	:
+	_val(other._val)
 {
-	switch (Type())
-	{
-	case Type::String: delete String(); break;
-	case Type::IntArr: delete IntArr(); break;
-	case Type::DoubleArr: delete DoubleArr(); break;
-	case Type::BoolArr: delete BoolArr(); break;
-	case Type::CharArr: delete CharArr(); break;
-	case Type::StringArr: delete StringArr(); break;
-	case Type::Struct: delete VStruct(); break;
-	case Type::StructArr: delete StructArr(); break;
-	default: break;
-	}
-
-	_val = other._val;
-
-	switch (Type())
-	{
-	case Type::String: _val = new std::string(*String()); break;
-	case Type::IntArr: _val = new std::vector<int>(*IntArr()); break;
-	case Type::DoubleArr: _val = new std::vector<double>(*DoubleArr()); break;
-	case Type::BoolArr: _val = new std::vector<bool>(*BoolArr()); break;
-	case Type::CharArr: _val = new std::vector<short>(*CharArr()); break;
-	case Type::StringArr: _val = new std::vector<std::string>(*StringArr()); break;
-	case Type::Struct: _val = new Struct(*VStruct()); break;
-	case Type::StructArr: _val = new std::vector<Struct>(*StructArr()); break;
-	default: break;
-	}
+	if (type() == Type::String && String() != nullptr)
+		_val = new std::string(*String());
 }
 
 Value::Value(Value&& other) noexcept
+	:
+	_val(other._val)
 {
-	switch (Type())
-	{
-	case Type::String: delete String(); break;
-	case Type::IntArr: delete IntArr(); break;
-	case Type::DoubleArr: delete DoubleArr(); break;
-	case Type::BoolArr: delete BoolArr(); break;
-	case Type::CharArr: delete CharArr(); break;
-	case Type::StringArr: delete StringArr(); break;
-	case Type::Struct: delete VStruct(); break;
-	case Type::StructArr: delete StructArr(); break;
-	default: break;
-	}
-
-	_val = other._val;
-
-	switch (Type())
-	{
-	case Type::String: other.String() = nullptr; break;
-	case Type::IntArr: other.IntArr() = nullptr; break;
-	case Type::DoubleArr: other.DoubleArr() = nullptr; break;
-	case Type::BoolArr: other.BoolArr() = nullptr; break;
-	case Type::CharArr: other.CharArr() = nullptr; break;
-	case Type::StringArr: other.StringArr() = nullptr; break;
-	case Type::Struct: other.VStruct() = nullptr; break;
-	case Type::StructArr: other.StructArr() = nullptr; break;
-	default: break;
-	}
+	if (type() == Type::String)
+		other.String() = nullptr;
 }
 
 Value& Value::operator=(const Value& other)
 {
-	switch (Type())
-	{
-	case Type::String: delete String(); break;
-	case Type::IntArr: delete IntArr(); break;
-	case Type::DoubleArr: delete DoubleArr(); break;
-	case Type::BoolArr: delete BoolArr(); break;
-	case Type::CharArr: delete CharArr(); break;
-	case Type::StringArr: delete StringArr(); break;
-	case Type::Struct: delete VStruct(); break;
-	case Type::StructArr: delete StructArr(); break;
-	default: break;
-	}
+	if (this == &other) return *this;
+
+	if (type() == Type::String)
+		delete String();
 
 	_val = other._val;
 
-	switch (Type())
-	{
-	case Type::String: _val = new std::string(*String()); break;
-	case Type::IntArr: _val = new std::vector<int>(*IntArr()); break;
-	case Type::DoubleArr: _val = new std::vector<double>(*DoubleArr()); break;
-	case Type::BoolArr: _val = new std::vector<bool>(*BoolArr()); break;
-	case Type::CharArr: _val = new std::vector<short>(*CharArr()); break;
-	case Type::StringArr: _val = new std::vector<std::string>(*StringArr()); break;
-	case Type::Struct: _val = new Struct(*VStruct()); break;
-	case Type::StructArr: _val = new std::vector<Struct>(*StructArr()); break;
-	default: break;
-	}
-	
+	if (type() == Type::String && String() != nullptr)
+		_val = new std::string(*String());
+
 	return *this;
 }
 
 Value& Value::operator=(Value&& other) noexcept
 {
-	switch (Type())
-	{
-	case Type::String: delete String(); break;
-	case Type::IntArr: delete IntArr(); break;
-	case Type::DoubleArr: delete DoubleArr(); break;
-	case Type::BoolArr: delete BoolArr(); break;
-	case Type::CharArr: delete CharArr(); break;
-	case Type::StringArr: delete StringArr(); break;
-	case Type::Struct: delete VStruct(); break;
-	case Type::StructArr: delete StructArr(); break;
-	default: break;
-	}
+	if (this == &other) return *this;
+
+	if (type() == Type::String)
+		delete String();
 
 	_val = other._val;
 
-	switch (Type())
-	{
-	case Type::String: other.String() = nullptr; break;
-	case Type::IntArr: other.IntArr() = nullptr; break;
-	case Type::DoubleArr: other.DoubleArr() = nullptr; break;
-	case Type::BoolArr: other.BoolArr() = nullptr; break;
-	case Type::CharArr: other.CharArr() = nullptr; break;
-	case Type::StringArr: other.StringArr() = nullptr; break;
-	case Type::Struct: other.VStruct() = nullptr; break;
-	case Type::StructArr: other.StructArr() = nullptr; break;
-	default: break;
-	}
+	if (type() == Type::String)
+		other.String() = nullptr;
 
 	return *this;
 }
 
 Value::~Value()
 {
-	switch (Type())
-	{
-	case Type::String: delete String(); break;
-	case Type::IntArr: delete IntArr(); break;
-	case Type::DoubleArr: delete DoubleArr(); break;
-	case Type::BoolArr: delete BoolArr(); break;
-	case Type::CharArr: delete CharArr(); break;
-	case Type::StringArr: delete StringArr(); break;
-	case Type::Struct: delete VStruct(); break;
-	case Type::StructArr: delete StructArr(); break;
-	default: break;
-	}
+	if (type() == Type::String)
+		delete String();
 }
 
 Value::Value(int v)
@@ -225,6 +146,21 @@ Value::Value(std::vector<Struct> v)
 	_val(new std::vector<Struct>(std::move(v)))
 {}
 
+Value::Value(std::vector<uint8_t> v)
+	:
+	_val(new std::vector<uint8_t>(std::move(v)))
+{}
+
+Value::Value(Matrix v)
+	:
+	_val(new Matrix(std::move(v)))
+{}
+
+Value::Value(Dictionary v)
+	:
+	_val(new Dictionary(std::move(v)))
+{}
+
 Type Value::type() const
 {
 	return (Type)_val.index();
@@ -243,6 +179,75 @@ std::string Value::U8CharToString(short ch)
 	return s;
 }
 
+char* Value::FormatInt(char* buff, int i)
+{
+	return std::to_chars(buff, buff + NumberBufferSize, i).ptr;
+}
+
+char* Value::FormatDouble(char* buff, double d)
+{
+	char* end = std::to_chars(buff, buff + NumberBufferSize, d, std::chars_format::fixed).ptr;
+	if (!std::isfinite(d)) return end;
+	char* point = std::find(buff, end, '.');
+	if (point != end)
+	{
+		*point = ',';
+		return end;
+	}
+	*end++ = ',';
+	*end++ = '0';
+	return end;
+}
+
+std::string Value::IntToString(int i)
+{
+	char buff[NumberBufferSize];
+	return std::string(buff, FormatInt(buff, i));
+}
+
+std::string Value::DoubleToString(double d)
+{
+	char buff[NumberBufferSize];
+	return std::string(buff, FormatDouble(buff, d));
+}
+
+//skip what std::stoi/std::stod skip before the number, from_chars does not take a leading '+'
+static std::string_view skipNumberPrefix(std::string_view str)
+{
+	size_t start = str.find_first_not_of(" \t\n\v\f\r");
+	if (start == std::string_view::npos) return std::string_view();
+	str.remove_prefix(start);
+	if (str.size() > 1 && str[0] == '+' && str[1] != '-') str.remove_prefix(1);
+	return str;
+}
+
+bool Value::ParseInt(std::string_view str, int& out)
+{
+	str = skipNumberPrefix(str);
+	return std::from_chars(str.data(), str.data() + str.size(), out).ec == std::errc();
+}
+
+bool Value::ParseDouble(std::string_view str, double& out)
+{
+	str = skipNumberPrefix(str);
+	size_t comma = str.find(',');
+	if (comma == std::string_view::npos)
+		return std::from_chars(str.data(), str.data() + str.size(), out).ec == std::errc();
+
+	//from_chars only knows the decimal point, so parse a copy with the comma replaced
+	char buff[64];
+	std::string longStr;
+	char* copy = buff;
+	if (str.size() > sizeof(buff))
+	{
+		longStr.resize(str.size());
+		copy = longStr.data();
+	}
+	std::copy(str.begin(), str.end(), copy);
+	copy[comma] = '.';
+	return std::from_chars(copy, copy + str.size(), out).ec == std::errc();
+}
+
 int& Value::Int()
 {
 	return std::get<int>(_val);
@@ -302,3 +307,40 @@ std::vector<Value::Struct>*& Value::StructArr()
 {
 	return std::get<std::vector<Struct>*>(_val);
 }
+
+std::vector<uint8_t>*& Value::Bytes()
+{
+	return std::get<std::vector<uint8_t>*>(_val);
+}
+
+Value::Matrix*& Value::VMatrix()
+{
+	return std::get<Matrix*>(_val);
+}
+
+Dictionary*& Value::VDictionary()
+{
+	return std::get<Dictionary*>(_val);
+}
+
+std::string Value::DictionaryToString()
+{
+	std::ostringstream ostr;
+	ostr << u8"{";
+	bool first = true;
+	VDictionary()->forEach([&](Value& key, Value& value) {
+		if (!first) ostr << u8"; ";
+		first = false;
+		if (key.type() == Type::String)
+			ostr << u8"\"" << *key.String() << u8"\"";
+		else
+			key.print(ostr);
+		ostr << u8": ";
+		if (value.type() == Type::String)
+			ostr << u8"\"" << *value.String() << u8"\"";
+		else
+			value.print(ostr);
+	});
+	ostr << u8"}";
+	return ostr.str();
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <vector>
 #include <variant>
 #include <algorithm>
@@ -24,6 +26,9 @@ enum class Type
 	CharArr,
 	StringArr,
 	StructArr,
+	Bytes, //an array of bytes, its elements are Zahlen
+	Matrix, //a 2D grid of Kommazahlen
+	Dictionary, //a Woerterbuch, Texte or Zahlen mapped to any Value
 	Any, //not inside Value, only used for native functions that take any or multiple types as Arguments
 	Function, //not inside Value, but used in the compiler to indicate wether a variable is a function
 };
@@ -59,6 +64,9 @@ struct ValueType
 
 bool isArr(Type t);
 bool isArr(ValueType t);
+Type elementType(Type arrType); //the type of the elements of an array type
+
+class Dictionary; //Dictionary.h, it holds Values itself
 
 class Value
 {
@@ -68,15 +76,21 @@ public:
 		std::unordered_map<std::string, Value> fields;
 		std::string identifier;
 	};
+	struct Matrix
+	{
+		int rows;
+		int cols;
+		std::vector<double> data; //row after row, element (row, col) is data[row * cols + col]
+	};
 public:
 	Value(); //constructed with std::monostate
-	Value(const Value& other); //copy the resources and allocate a new pointer if necessary
+	Value(const Value& other); //copies a Text, arrays and structs share their pointer
 	Value(Value&& other) noexcept; //take the resources and take ownership of the pointer if necessary
 
 	Value& operator=(const Value& other);
 	Value& operator=(Value&& other) noexcept;
 
-	~Value(); //delete the pointer if necessary
+	~Value(); //delete the pointer of a Text
 
 	//constructors for the various types
 	Value(int v);
@@ -92,24 +106,35 @@ public:
 	Value(std::vector<std::string> v);
 	Value(Struct v);
 	Value(std::vector<Struct> v);
+	Value(std::vector<uint8_t> v);
+	Value(Matrix v);
+	Value(Dictionary v);
 
 	Type type() const; //return the current type of the variant
 
 	static std::string U8CharToString(short ch);
 
+	static constexpr size_t NumberBufferSize = 330; //big enough for every int and every double FormatInt/FormatDouble write, the smallest double has 324 decimals
+	//write i into buff and return the end of the written characters
+	static char* FormatInt(char* buff, int i);
+	//write the shortest digits of d that still read back as d into buff and return the end of the written characters.
+	//Never with an exponent and always with a german decimal comma and at least one decimal, so 2,0 does not look like a Zahl
+	static char* FormatDouble(char* buff, double d);
+	static std::string IntToString(int i);
+	static std::string DoubleToString(double d);
+	//read a number like std::stoi/std::stod would (leading whitespace is skipped, trailing characters are ignored), but without exceptions or the locale.
+	//ParseDouble takes a german decimal comma as well as a point. Both return false if str does not start with a number that fits into out
+	static bool ParseInt(std::string_view str, int& out);
+	static bool ParseDouble(std::string_view str, double& out);
+
 	template<class stream>
 	void print(stream& ostr)
 	{
+		char buff[NumberBufferSize];
 		switch (this->type())
 		{
-		case Type::Int: ostr << this->Int(); break;
-		case Type::Double:
-		{
-			std::string str = std::to_string(this->Double());
-			std::replace(str.begin(), str.end(), '.', ',');
-			ostr << str;
-			break;
-		}
+		case Type::Int: ostr << std::string_view(buff, FormatInt(buff, this->Int()) - buff); break;
+		case Type::Double: ostr << std::string_view(buff, FormatDouble(buff, this->Double()) - buff); break;
 		case Type::Bool: ostr << (this->Bool() ? u8"wahr" : u8"falsch"); break;
 		case Type::Char: ostr << U8CharToString(this->Char()); break;
 		case Type::String: ostr << *this->String(); break;
@@ -124,9 +149,9 @@ public:
 			ostr << u8"[";
 			for (int i = 0; i < (int)vec->size() - 1; i++)
 			{
-				ostr << vec->at(i) << u8"; ";
+				ostr << std::string_view(buff, FormatInt(buff, (*vec)[i]) - buff) << u8"; ";
 			}
-			ostr << vec->at(vec->size() - 1) << u8"]";
+			ostr << std::string_view(buff, FormatInt(buff, vec->back()) - buff) << u8"]";
 			break;
 		}
 		case Type::DoubleArr:
@@ -140,9 +165,25 @@ public:
 			ostr << u8"[";
 			for (int i = 0; i < (int)vec->size() - 1; i++)
 			{
-				ostr << vec->at(i) << u8"; ";
+				ostr << std::string_view(buff, FormatDouble(buff, (*vec)[i]) - buff) << u8"; ";
 			}
-			ostr << vec->at(vec->size() - 1) << u8"]";
+			ostr << std::string_view(buff, FormatDouble(buff, vec->back()) - buff) << u8"]";
+			break;
+		}
+		case Type::Bytes:
+		{
+			std::vector<uint8_t>*& vec = this->Bytes();
+			if (vec->empty())
+			{
+				ostr << u8"[]";
+				return;
+			}
+			ostr << u8"[";
+			for (int i = 0; i < (int)vec->size() - 1; i++)
+			{
+				ostr << std::string_view(buff, FormatInt(buff, (*vec)[i]) - buff) << u8"; ";
+			}
+			ostr << std::string_view(buff, FormatInt(buff, vec->back()) - buff) << u8"]";
 			break;
 		}
 		case Type::BoolArr:
@@ -219,6 +260,25 @@ public:
 			ostr << u8"}";
 			break;
 		}
+		case Type::Matrix:
+		{
+			Matrix*& m = this->VMatrix();
+			ostr << u8"[";
+			for (int row = 0; row < m->rows; row++)
+			{
+				if (row > 0) ostr << u8"; ";
+				ostr << u8"[";
+				for (int col = 0; col < m->cols; col++)
+				{
+					if (col > 0) ostr << u8"; ";
+					ostr << std::string_view(buff, FormatDouble(buff, m->data[(size_t)row * m->cols + col]) - buff);
+				}
+				ostr << u8"]";
+			}
+			ostr << u8"]";
+			break;
+		}
+		case Type::Dictionary: ostr << DictionaryToString(); break;
 		case Type::StructArr:
 		{
 			std::vector<Struct>*& sarr = this->StructArr();
@@ -254,6 +314,11 @@ public:
 	std::vector<short>*& CharArr();
 	std::vector<std::string>*& StringArr();
 	std::vector<Struct>*& StructArr();
+	std::vector<uint8_t>*& Bytes();
+	Matrix*& VMatrix();
+	Dictionary*& VDictionary();
+private:
+	std::string DictionaryToString(); //print needs the definition of Dictionary, which needs Value
 private:
 	std::variant<
 		std::monostate,
@@ -268,7 +333,10 @@ private:
 		std::vector<bool>*,
 		std::vector<short>*,
 		std::vector<std::string>*,
-		std::vector<Struct>*
+		std::vector<Struct>*,
+		std::vector<uint8_t>*,
+		Matrix*,
+		Dictionary*
 	> _val;
 };
 
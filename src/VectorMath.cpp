@@ -0,0 +1,199 @@
+#include "VectorMath.h"
+
+#if defined(_M_X64) || defined(_M_IX86)
+#define VECTORMATH_X86
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	struct Kernels
+	{
+		void (*add)(const double*, const double*, double*, size_t);
+		void (*multiply)(const double*, const double*, double*, size_t);
+		void (*scale)(const double*, double, double*, size_t);
+		void (*axpy)(double, const double*, const double*, double*, size_t);
+		double (*dot)(const double*, const double*, size_t);
+		const char* name;
+	};
+
+	namespace Scalar
+	{
+		void add(const double* a, const double* b, double* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++) out[i] = a[i] + b[i];
+		}
+
+		void multiply(const double* a, const double* b, double* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++) out[i] = a[i] * b[i];
+		}
+
+		void scale(const double* a, double factor, double* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++) out[i] = a[i] * factor;
+		}
+
+		void axpy(double alpha, const double* x, const double* y, double* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++) out[i] = alpha * x[i] + y[i];
+		}
+
+		double dot(const double* a, const double* b, size_t n)
+		{
+			double sum = 0.0;
+			for (size_t i = 0; i < n; i++) sum += a[i] * b[i];
+			return sum;
+		}
+	}
+
+#ifdef VECTORMATH_X86
+	//2 doubles at once, the rest is done by the scalar loop
+	namespace SSE2
+	{
+		void add(const double* a, const double* b, double* out, size_t n)
+		{
+			size_t i = 0;
+			for (; i + 2 <= n; i += 2)
+				_mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+			Scalar::add(a + i, b + i, out + i, n - i);
+		}
+
+		void multiply(const double* a, const double* b, double* out, size_t n)
+		{
+			size_t i = 0;
+			for (; i + 2 <= n; i += 2)
+				_mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+			Scalar::multiply(a + i, b + i, out + i, n - i);
+		}
+
+		void scale(const double* a, double factor, double* out, size_t n)
+		{
+			__m128d f = _mm_set1_pd(factor);
+			size_t i = 0;
+			for (; i + 2 <= n; i += 2)
+				_mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(a + i), f));
+			Scalar::scale(a + i, factor, out + i, n - i);
+		}
+
+		void axpy(double alpha, const double* x, const double* y, double* out, size_t n)
+		{
+			__m128d al = _mm_set1_pd(alpha);
+			size_t i = 0;
+			for (; i + 2 <= n; i += 2)
+				_mm_storeu_pd(out + i, _mm_add_pd(_mm_mul_pd(al, _mm_loadu_pd(x + i)), _mm_loadu_pd(y + i)));
+			Scalar::axpy(alpha, x + i, y + i, out + i, n - i);
+		}
+
+		double dot(const double* a, const double* b, size_t n)
+		{
+			//two sums, so an add does not have to wait for the one before
+			__m128d sum0 = _mm_setzero_pd();
+			__m128d sum1 = _mm_setzero_pd();
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				sum0 = _mm_add_pd(sum0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+				sum1 = _mm_add_pd(sum1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+			}
+			double parts[2];
+			_mm_storeu_pd(parts, _mm_add_pd(sum0, sum1));
+			return parts[0] + parts[1] + Scalar::dot(a + i, b + i, n - i);
+		}
+	}
+
+	//4 doubles at once, only with AVX instructions. Multiply and add stay separate instead of fma, so the results match the other kernels
+	namespace AVX
+	{
+		void add(const double* a, const double* b, double* out, size_t n)
+		{
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+				_mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+			Scalar::add(a + i, b + i, out + i, n - i);
+		}
+
+		void multiply(const double* a, const double* b, double* out, size_t n)
+		{
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+				_mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+			Scalar::multiply(a + i, b + i, out + i, n - i);
+		}
+
+		void scale(const double* a, double factor, double* out, size_t n)
+		{
+			__m256d f = _mm256_set1_pd(factor);
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+				_mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), f));
+			Scalar::scale(a + i, factor, out + i, n - i);
+		}
+
+		void axpy(double alpha, const double* x, const double* y, double* out, size_t n)
+		{
+			__m256d al = _mm256_set1_pd(alpha);
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+				_mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_mul_pd(al, _mm256_loadu_pd(x + i)), _mm256_loadu_pd(y + i)));
+			Scalar::axpy(alpha, x + i, y + i, out + i, n - i);
+		}
+
+		double dot(const double* a, const double* b, size_t n)
+		{
+			__m256d sum0 = _mm256_setzero_pd();
+			__m256d sum1 = _mm256_setzero_pd();
+			size_t i = 0;
+			for (; i + 8 <= n; i += 8)
+			{
+				sum0 = _mm256_add_pd(sum0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+				sum1 = _mm256_add_pd(sum1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+			}
+			double parts[4];
+			_mm256_storeu_pd(parts, _mm256_add_pd(sum0, sum1));
+			return (parts[0] + parts[1]) + (parts[2] + parts[3]) + Scalar::dot(a + i, b + i, n - i);
+		}
+	}
+
+	bool hasAVX()
+	{
+		int info[4];
+		__cpuid(info, 1);
+		bool osSavesYmm = (info[2] & (1 << 27)) != 0; //OSXSAVE
+		bool avx = (info[2] & (1 << 28)) != 0;
+		if (!osSavesYmm || !avx) return false;
+		//the os has to save the upper halves of the ymm registers on a context switch
+		return (_xgetbv(0) & 0x6) == 0x6;
+	}
+
+	bool hasSSE2()
+	{
+		int info[4];
+		__cpuid(info, 1);
+		return (info[3] & (1 << 26)) != 0;
+	}
+#endif
+
+	Kernels selectKernels()
+	{
+#ifdef VECTORMATH_X86
+		if (hasAVX()) return { AVX::add, AVX::multiply, AVX::scale, AVX::axpy, AVX::dot, "AVX" };
+		if (hasSSE2()) return { SSE2::add, SSE2::multiply, SSE2::scale, SSE2::axpy, SSE2::dot, "SSE2" };
+#endif
+		return { Scalar::add, Scalar::multiply, Scalar::scale, Scalar::axpy, Scalar::dot, "Skalar" };
+	}
+
+	const Kernels kernels = selectKernels();
+}
+
+namespace VectorMath
+{
+	void add(const double* a, const double* b, double* out, size_t n) { kernels.add(a, b, out, n); }
+	void multiply(const double* a, const double* b, double* out, size_t n) { kernels.multiply(a, b, out, n); }
+	void scale(const double* a, double factor, double* out, size_t n) { kernels.scale(a, factor, out, n); }
+	void axpy(double alpha, const double* x, const double* y, double* out, size_t n) { kernels.axpy(alpha, x, y, out, n); }
+	double dot(const double* a, const double* b, size_t n) { return kernels.dot(a, b, n); }
+
+	const char* instructionSet() { return kernels.name; }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+//element-wise math over arrays of doubles for the Kommazahlen natives.
+//The kernels are picked once at startup from what the cpu supports: AVX, SSE2 or plain scalar loops.
+//All of them round exactly like the scalar loop, only dot sums in a different order
+namespace VectorMath
+{
+	void add(const double* a, const double* b, double* out, size_t n); //out[i] = a[i] + b[i]
+	void multiply(const double* a, const double* b, double* out, size_t n); //out[i] = a[i] * b[i]
+	void scale(const double* a, double factor, double* out, size_t n); //out[i] = a[i] * factor
+	void axpy(double alpha, const double* x, const double* y, double* out, size_t n); //out[i] = alpha * x[i] + y[i]
+	double dot(const double* a, const double* b, size_t n); //the sum of a[i] * b[i]
+
+	const char* instructionSet(); //the name of the kernels that are used, shown by --info
+}
@@ -1,10 +1,20 @@
 #include "VirtualMachine.h"
-#include "Compiler.h"
 #include <iostream>
+#include <random>
 
-VirtualMachine::VirtualMachine(const std::string& filePath, const std::vector<std::string>& sysArgs)
+//the seed from the command line or a random one
+static uint64_t getSeed(const RunOptions& options)
+{
+	if (options.seed) return *options.seed;
+	std::random_device dev;
+	return ((uint64_t)dev() << 32) | dev();
+}
+
+VirtualMachine::VirtualMachine(const std::string& filePath, const std::vector<std::string>& sysArgs, const RunOptions& options)
 	:
-	filePath(filePath)
+	filePath(filePath),
+	runtime(options.flushPolicy, getSeed(options)),
+	compiler(filePath, &globals, &functions, &structs, options.eagerCompilation)
 {
 	globals.insert(std::make_pair("System_Argumente", Value(sysArgs)));
 }
@@ -13,26 +23,28 @@ InterpretResult VirtualMachine::run()
 {
 	try
 	{
-		{
-			Compiler compiler(filePath, &globals, &functions, &structs);
-			if (!compiler.compile()) return InterpretResult::CompileTimeError;
-		}
-		functions.at("").run(&globals, &functions, &structs);
+		if (!compiler.compile()) return InterpretResult::CompileTimeError;
+		functions.at("").run(&globals, &functions, &structs, &runtime);
+		runtime.tasks.waitForAll(); //report errors of tasks that were never awaited
 	}
 	catch (runtime_error& err)
 	{
+		runtime.out.flush(); //print the output of the program before the error
 		std::cerr << u8"[runtime error] " << err.what() << "\n";
 		return InterpretResult::RuntimeError;
 	}
 	catch (std::exception& e)
 	{
+		runtime.out.flush();
 		std::cerr << "[standard exception] " << e.what() << "\n";
 		return InterpretResult::Exception;
 	}
 	catch (...)
 	{
+		runtime.out.flush();
 		std::cerr << "Something went badly wrong!\n";
 		return InterpretResult::Exception;
 	}
+	runtime.out.flush();
 	return InterpretResult::OK;
 }
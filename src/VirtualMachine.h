@@ -1,6 +1,7 @@
 #pragma once
 
-#include "Function.h"
+#include "Compiler.h"
+#include <optional>
 
 enum class InterpretResult
 {
@@ -10,10 +11,18 @@ enum class InterpretResult
 	Exception
 };
 
+//settings given on the command line
+struct RunOptions
+{
+	bool eagerCompilation = false; //compile all function bodies before running (--eager)
+	OutputBuffer::FlushPolicy flushPolicy = OutputBuffer::FlushPolicy::Line; //when the output of the program is written (--puffer=...)
+	std::optional<uint64_t> seed; //seed of the random numbers, so a run can be repeated (--seed=...). Random if not given
+};
+
 class VirtualMachine
 {
 public:
-	VirtualMachine(const std::string& filePath, const std::vector<std::string>& sysArgs);
+	VirtualMachine(const std::string& filePath, const std::vector<std::string>& sysArgs, const RunOptions& options);
 
 	InterpretResult run();
 private:
@@ -22,5 +31,8 @@ private:
 	std::unordered_map<std::string, Value> globals;
 	std::unordered_map<std::string, Function> functions;
 	std::unordered_map<std::string, Value::Struct> structs;
+	Natives::Runtime runtime;
+
+	Compiler compiler; //kept alive while running, so it can compile function bodies on their first call
 };
 
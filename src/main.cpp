@@ -1,8 +1,10 @@
 #include "VirtualMachine.h"
+#include "VectorMath.h"
 #include <iostream>
 #include <Windows.h>
 #include <io.h>
 #include <stdlib.h>
+#include <charconv>
 
 bool hasOwnWindow()
 {
@@ -15,9 +17,9 @@ void pauseIfWindowOwner()
 		system("pause");
 }
 
-int runFile(std::string file, std::vector<std::string> sysArgs)
+int runFile(std::string file, std::vector<std::string> sysArgs, const RunOptions& options)
 {
-	VirtualMachine vm(file, sysArgs);
+	VirtualMachine vm(file, sysArgs, options);
 	InterpretResult result = vm.run();
 	switch (result)
 	{
@@ -47,15 +49,49 @@ int main(int argc, char* argv[])
 		SetConsoleCP(CP_UTF8);
 	}
 
-	if (!hasOwnWindow())
-		std::cout << std::unitbuf;
+	RunOptions options;
+	//a console wants to see every line at once, a pipe or file is faster with big blocks
+	options.flushPolicy = _isatty(_fileno(stdout)) ? OutputBuffer::FlushPolicy::Line : OutputBuffer::FlushPolicy::Block;
 
-	switch (argc)
+	//options come before the filename, everything after it is passed to the program
+	int fileArg = 1;
+	for (; fileArg < argc && std::string(argv[fileArg]).rfind("--", 0) == 0; fileArg++)
 	{
-	case 1: std::cout << u8"Usage: ddp++ <filename.ddp>\n"; pauseIfWindowOwner(); break;
-	case 2: return runFile(argv[1], {});
-	default: return runFile(argv[1], std::vector<std::string>(argv + 2, argv + argc));
+		std::string option = argv[fileArg];
+		if (option == "--info")
+		{
+			std::cout << u8"Vektor Befehlssatz: " << VectorMath::instructionSet() << "\n";
+			return 0;
+		}
+		else if (option == "--eager") options.eagerCompilation = true;
+		else if (option == "--puffer=zeile") options.flushPolicy = OutputBuffer::FlushPolicy::Line;
+		else if (option == "--puffer=block") options.flushPolicy = OutputBuffer::FlushPolicy::Block;
+		else if (option == "--puffer=explizit") options.flushPolicy = OutputBuffer::FlushPolicy::Explicit;
+		else if (option.rfind("--seed=", 0) == 0)
+		{
+			uint64_t seed;
+			const char* first = option.data() + 7;
+			const char* last = option.data() + option.size();
+			auto [ptr, ec] = std::from_chars(first, last, seed);
+			if (ec != std::errc() || ptr != last || first == last)
+			{
+				std::cerr << u8"Ungltiger Seed '" << option.substr(7) << "'!\n";
+				return 1;
+			}
+			options.seed = seed;
+		}
+		else
+		{
+			std::cerr << u8"Unbekannte Option '" << option << "'!\n";
+			return 1;
+		}
 	}
 
-	return 0;
+	if (fileArg >= argc)
+	{
+		std::cout << u8"Usage: ddp++ [--info] [--eager] [--puffer=zeile|block|explizit] [--seed=<zahl>] <filename.ddp> [args...]\n";
+		pauseIfWindowOwner();
+		return 0;
+	}
+	return runFile(argv[fileArg], std::vector<std::string>(argv + fileArg + 1, argv + argc), options);
 }
\ No newline at end of file